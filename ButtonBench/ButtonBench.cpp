@@ -0,0 +1,187 @@
+#include "Button.h"
+#include "ButtonBatch.h"
+#include "SortedButtons.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//BENCHMARK : the per-frame loops over buttons and the hit-testing of a mouse move, printed in nanoseconds per button,
+//and the frame time of build_tree for each number of threads
+//Branch misses aren't counted here, run it under a profiler reading the counters (perf stat -e branch-misses, VTune...)
+
+namespace
+{
+	constexpr std::size_t button_count = 20000;
+	constexpr int bench_rounds = 7;
+	constexpr int bench_iterations = 10;
+
+	////////////////////////////////////////////////////////////
+	/// The fastest of several rounds : the slower ones measure what else the machine was doing
+	////////////////////////////////////////////////////////////
+	template<class F>
+	double nanoseconds_per_frame(F&& f)
+	{
+		f();//the first frame allocates
+		double best = std::numeric_limits<double>::max();
+		for (int round = 0; round < bench_rounds; ++round)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < bench_iterations; ++i)
+				f();
+			best = std::min(best, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+		}
+		return best / bench_iterations;
+	}
+
+	template<class F>
+	double nanoseconds_per_button(F&& f)
+	{
+		return nanoseconds_per_frame(std::forward<F>(f)) / button_count;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// Moves and recolors every button, both calls visit its shape
+	////////////////////////////////////////////////////////////
+	struct Update
+	{
+		float x{ 0.f };
+
+		template<class B>
+		void operator()(B& button)
+		{
+			x = x > 1000.f ? 0.f : x + 1.f;
+			button.set_position({ x, x / 2.f });
+			button.change_default_color(sf::Color(static_cast<sf::Uint8>(x), 128, 64));
+		}
+	};
+
+	template<class Storage>
+	void add_shape(Storage& storage, int kind, std::string const& id)
+	{
+		const auto add = [&](auto&& shape) {
+			if constexpr (std::is_same_v<Storage, Button>)
+				(void)storage.add(id, std::move(shape));
+			else
+				(void)storage.add(std::move(shape));
+		};
+		switch (kind)
+		{
+		case 0: add(sf::RectangleShape({ 20.f, 10.f })); break;
+		case 1: add(sf::CircleShape(8.f, 12)); break;
+		case 2: add(RectPrimitive({ 20.f, 10.f })); break;
+		default: add(CirclePrimitive(8.f)); break;
+		}
+	}
+
+	template<class Loop>
+	void bench_frame(char const* name, Loop&& for_each_button)
+	{
+		ButtonBatch batch;
+		Update update;
+		const double update_ns = nanoseconds_per_button([&] { for_each_button(update); });
+		const double submit_ns = nanoseconds_per_button([&] {
+			batch.clear();
+			for_each_button([&batch](auto const& b) { batch.push(b); });
+			batch.build();
+			});
+		std::printf("%-22s update %6.1f ns  submit and build %6.1f ns  %zu vertices\n", name, update_ns, submit_ns, batch.vertex_count());
+	}
+
+	////////////////////////////////////////////////////////////
+	/// The same buttons, four shape types in random order, in a Button tree and in a SortedButtons.
+	/// The variant dispatch of the tree can't guess the next type, the sorted storage runs one loop per type.
+	/// A tree holding the types one after another has the same layout but a predictable dispatch
+	////////////////////////////////////////////////////////////
+	void bench_sorted_storage()
+	{
+		std::mt19937 rng(1);
+		std::uniform_int_distribution<int> kind(0, 3);
+		std::vector<int> kinds(button_count);
+		for (auto& k : kinds)
+			k = kind(rng);
+
+		Button shuffled, grouped;
+		SortedButtons<sf::RectangleShape, sf::CircleShape, RectPrimitive, CirclePrimitive> sorted;
+		//one storage after the other, so the blocks of each one are allocated together
+		for (std::size_t i = 0; i < button_count; ++i)
+			add_shape(shuffled, kinds[i], "b" + std::to_string(i));
+		for (std::size_t i = 0; i < button_count; ++i)
+			add_shape(sorted, kinds[i], {});
+		std::ranges::sort(kinds);
+		for (std::size_t i = 0; i < button_count; ++i)
+			add_shape(grouped, kinds[i], "b" + std::to_string(i));
+
+		std::printf("%zu buttons of 4 shape types, per button :\n", button_count);
+		bench_frame("Button tree, shuffled", [&](auto&& f) { shuffled.for_each_child(f); });
+		bench_frame("Button tree, grouped", [&](auto&& f) { grouped.for_each_child(f); });
+		bench_frame("SortedButtons", [&](auto&& f) { sorted.for_each(f); });
+	}
+
+	////////////////////////////////////////////////////////////
+	/// A mouse move sent to every button of a grid : each one tests its cached bounds,
+	/// only the few under the cursor change their state and touch their cold block
+	////////////////////////////////////////////////////////////
+	void bench_hit_test()
+	{
+		constexpr std::size_t columns = 200;
+		Button root;
+		for (std::size_t i = 0; i < button_count; ++i)
+			(void)root.add("b" + std::to_string(i), sf::RectangleShape({ 20.f, 10.f }))
+				.set_position({ static_cast<float>(i % columns) * 25.f, static_cast<float>(i / columns) * 15.f });
+
+		sf::Event e{};
+		e.type = sf::Event::MouseMoved;
+		const double hit_ns = nanoseconds_per_button([&] {
+			e.mouseMove.x = (e.mouseMove.x + 7) % static_cast<int>(columns * 25);
+			e.mouseMove.y = (e.mouseMove.y + 3) % static_cast<int>(button_count / columns * 15);
+			root.apply_foreach<&Button::process_events>(e);
+			});
+		std::printf("%-22s %6.1f ns per button, sizeof(Button) %zu B\n", "hit-test, mouse moved", hit_ns, sizeof(Button));
+	}
+
+	////////////////////////////////////////////////////////////
+	/// Frame time of build_tree against its number of threads, on a tree of panels holding the four shape types.
+	/// Past the number of hardware threads the workers share the cores : those lines only show the cost of the split.
+	/// On a single core machine no scaling can show, run it on the target hardware
+	////////////////////////////////////////////////////////////
+	void bench_build_tree()
+	{
+		constexpr std::size_t panel_count = 100;
+		std::mt19937 rng(2);
+		std::uniform_int_distribution<int> kind(0, 3);
+		Button root;
+		for (std::size_t p = 0; p < panel_count; ++p)
+		{
+			auto& panel = root.add("p" + std::to_string(p), sf::RectangleShape({ 200.f, 100.f }));
+			for (std::size_t i = 0; i < button_count / panel_count; ++i)
+				add_shape(panel, kind(rng), "b" + std::to_string(i));
+		}
+
+		const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+		std::printf("build_tree of %zu buttons, hardware threads : %u\n", button_count + panel_count, cores);
+		ButtonBatch batch;
+		double single = 0.;
+		for (unsigned threads = 1; threads <= std::max(cores, 8u); threads *= 2)
+		{
+			const double frame_ns = nanoseconds_per_frame([&] { batch.build_tree(root, threads); });
+			if (threads == 1)
+				single = frame_ns;
+			std::printf("%2u threads  %8.1f us per frame  x%.2f  %zu vertices%s\n", threads, frame_ns / 1000., single / frame_ns,
+				batch.vertex_count(), threads > cores ? "  (more threads than cores)" : "");
+		}
+	}
+}
+
+int main()
+{
+	bench_sorted_storage();
+	bench_hit_test();
+	bench_build_tree();
+	return 0;
+}
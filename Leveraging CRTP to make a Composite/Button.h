@@ -2,9 +2,13 @@
 #define BUTTON_H
 
 #include "Container.h"
+#include "ButtonBatch.h"
+#include "ButtonStyle.h"
+#include "Primitives.h"
 #include <array>
 #include <variant>
 #include <functional>
+#include <type_traits>
 #include "SFML/Graphics/Texture.hpp"  // for Texture (ptr only)
 #include "SFML/Window/Event.hpp"
 #include "SFML/Graphics/CircleShape.hpp"
@@ -19,44 +23,91 @@
 #elif _MSC_VER
 #endif
 
-class Button : public Container<Button>// must be publicly inherited ! 
+////////////////////////////////////////////////////////////
+/// \brief A button whose shape is one of Shapes...
+/// Example : using HudButton = BasicButton<sf::RectangleShape>;
+///
+/// With a single shape type the shape is stored as is and used without any std::visit.
+/// Your own shape types work too, as long as they have the functions of sf::Shape or sf::Sprite
+/// that the members you call rely on (setPosition, getGlobalBounds, setFillColor or setColor...)
+////////////////////////////////////////////////////////////
+template<class ...Shapes>
+class BasicButton : public Container<BasicButton<Shapes...>>// must be publicly inherited !
 {
+	static_assert(sizeof...(Shapes) > 0, "A button needs at least one shape type");
+
+	using base_t = Container<BasicButton<Shapes...>>;
+
 public:
-	using shape_t = std::variant <sf::RectangleShape, sf::CircleShape, sf::ConvexShape, sf::Sprite>;//can be extended if you want
+	using shape_t = std::conditional_t<sizeof...(Shapes) == 1, std::tuple_element_t<0, std::tuple<Shapes...>>, std::variant<Shapes...>>;
+	using style_t = BasicStyle<Shapes...>;
+
+	////////////////////////////////////////////////////////////
+	/// \brief What draw_visible did during one call : buttons drawn, buttons skipped,
+	/// and among the skipped ones those whose whole subtree was skipped with them
+	////////////////////////////////////////////////////////////
+	struct CullStats
+	{
+		std::size_t drawn{ 0 };
+		std::size_t culled{ 0 };
+		std::size_t culled_subtrees{ 0 };
+	};
 
 	////////////////////////////////////////////////////////////
 	/// \brief Default constructor
 	///
 	////////////////////////////////////////////////////////////
-	Button() = default;
+	BasicButton() = default;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Create a button from this list of arguments
 	///
 	////////////////////////////////////////////////////////////
-	explicit Button(Button* _parent, shape_t const& _shape_in, sf::Text const& _text_in = {}) noexcept :
-		Container<Button>(_parent), m_shapes{ _shape_in }, m_text{ _text_in }{}
-	explicit Button(Button* _parent, shape_t&& _shape_in, sf::Text&& _text_in = {}) noexcept :
-		Container<Button>(_parent), m_shapes{ std::move(_shape_in) }, m_text{ std::move(_text_in) }{}
-	explicit Button(Button* _parent, sf::Text const& _text_in) noexcept :
-		Container<Button>(_parent), m_text{ _text_in }{}
-	explicit Button(Button* _parent, sf::Text&& _text_in) noexcept :
-		Container<Button>(_parent), m_text{ std::move(_text_in) }{}
+	explicit BasicButton(BasicButton* _parent, shape_t const& _shape_in, sf::Text const& _text_in = {}) noexcept :
+		base_t(_parent), m_cold{ make_cold(_shape_in, _text_in) } { refresh_bounds(); }
+	explicit BasicButton(BasicButton* _parent, shape_t&& _shape_in, sf::Text&& _text_in = {}) noexcept :
+		base_t(_parent), m_cold{ make_cold(std::move(_shape_in), std::move(_text_in)) } { refresh_bounds(); }
+	explicit BasicButton(BasicButton* _parent, sf::Text const& _text_in) noexcept :
+		base_t(_parent), m_cold{ make_cold(shape_t(), _text_in) } { refresh_bounds(); }
+	explicit BasicButton(BasicButton* _parent, sf::Text&& _text_in) noexcept :
+		base_t(_parent), m_cold{ make_cold(shape_t(), std::move(_text_in)) } { refresh_bounds(); }
 	////////////////////////////////////////////////////////////
 	/// \brief Create a button from this list of arguments
 	///
 	////////////////////////////////////////////////////////////
-	Button(shape_t const& _shape_in, sf::Text const& _text_in = {}) noexcept :
-		m_shapes{ _shape_in }, m_text{ _text_in }{}
-	Button(shape_t&& _shape_in, sf::Text&& _text_in = {}) noexcept :
-		m_shapes{ std::move(_shape_in) }, m_text{ std::move(_text_in) }{}
-	Button(sf::Text const& _text_in) noexcept : m_text{ _text_in } {}
-	Button(sf::Text&& _text_in) noexcept : m_text{ std::move(_text_in) } {}
+	BasicButton(shape_t const& _shape_in, sf::Text const& _text_in = {}) noexcept :
+		m_cold{ make_cold(_shape_in, _text_in) } { refresh_bounds(); }
+	BasicButton(shape_t&& _shape_in, sf::Text&& _text_in = {}) noexcept :
+		m_cold{ make_cold(std::move(_shape_in), std::move(_text_in)) } { refresh_bounds(); }
+	BasicButton(sf::Text const& _text_in) noexcept : m_cold{ make_cold(shape_t(), _text_in) } { refresh_bounds(); }
+	BasicButton(sf::Text&& _text_in) noexcept : m_cold{ make_cold(shape_t(), std::move(_text_in)) } { refresh_bounds(); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Copy a button without its children, what Container::clone and Container::instantiate call
+	///
+	/// The shape, the label and the callback are copied, the style, the textures and the font are shared with the prototype
+	////////////////////////////////////////////////////////////
+	explicit BasicButton(BasicButton* _parent, BasicButton const& _prototype) :
+		base_t(_parent), m_hot{ _prototype.m_hot }, m_cold{ copy_cold(*_prototype.m_cold) } {}
 
 	void create_function_call(std::function<void()>)noexcept;
 	void process_events(sf::Event const&);
 	void draw(sf::RenderWindow&)const;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Queue the button in a batch instead of drawing it right now
+	/// Example : parent.apply_foreach<&Button::submit>(batch);
+	////////////////////////////////////////////////////////////
+	void submit(ButtonBatch&)const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the button and its descendants, skipping those outside the current view of the window
+	/// Example : auto stats = parent.draw_visible(App);
+	///
+	/// \return How many buttons were drawn and culled during this call
+	////////////////////////////////////////////////////////////
+	CullStats draw_visible(sf::RenderWindow&)const;
+
 	////////////////////////////////////////////////////////////
 	/// \return True if the cursor of your mouse is in the button, False otherwise
 	////////////////////////////////////////////////////////////
@@ -64,16 +115,55 @@ public:
 	sf::Vector2f get_position()const noexcept;
 	sf::FloatRect get_globalbounds()const noexcept;
 
+	////////////////////////////////////////////////////////////
+	/// \return The shape drawn for the current state : the own shape of the button, or the one of its style placed at (0, 0)
+	////////////////////////////////////////////////////////////
+	shape_t const& get_shape()const noexcept { return m_hot.styled ? m_cold->style->get_shape(m_hot.state) : m_cold->look->shape; }
+
+	////////////////////////////////////////////////////////////
+	/// \return The translation to apply to get_shape() when drawing it : the position of a styled button, (0, 0) otherwise
+	////////////////////////////////////////////////////////////
+	sf::Vector2f get_shape_translation()const noexcept { return m_hot.styled ? m_cold->position : sf::Vector2f(); }
+
+	////////////////////////////////////////////////////////////
+	/// \return The label, nullptr for buttons built without text and never given a string.
+	/// A styled button first gives its label the font and the size of its style.
+	////////////////////////////////////////////////////////////
+	sf::Text const* get_text()const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Call a function with the concrete shape of get_shape(), std::visit is only used when there are several shape types
+	////////////////////////////////////////////////////////////
+	template<class F>
+	decltype(auto) visit_shape(F&& f)const { return visit(std::forward<F>(f), get_shape()); }
+
 	//Chaining functions for convenience
 
-	Button& set_color_state(sf::Color const&, sf::Color const&, sf::Color const&);
-	Button& set_texture_state(sf::Texture const&, sf::Texture const&, sf::Texture const&);
-	Button& set_position(sf::Vector2f const&);
-	Button& set_origin();
-	Button& set_rotation(float);
-	Button& set_string(std::string const&);
+	BasicButton& set_color_state(sf::Color const&, sf::Color const&, sf::Color const&);
+	BasicButton& set_texture_state(sf::Texture const&, sf::Texture const&, sf::Texture const&);
+	BasicButton& set_position(sf::Vector2f const&);
+	BasicButton& set_origin();
+	BasicButton& set_rotation(float);
+	BasicButton& set_string(std::string const&);
+
+	BasicButton& resize();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Promise that all the descendants stay inside the bounds of this button (panels, cards...),
+	/// so draw_visible skips the whole subtree when this button is out of view
+	////////////////////////////////////////////////////////////
+	BasicButton& set_encloses_children(bool) noexcept;
 
-	Button& resize();
+	////////////////////////////////////////////////////////////
+	/// \brief Draw this button with a shared style instead of its own shape, palette and textures (freed),
+	/// the button keeps its position. nullptr gives it back its own copy of the style.
+	/// Example : button.set_style(style).set_position({ 10.f, 10.f });
+	///
+	/// Any function changing the look of this button alone (set_color_state, set_rotation, resize...)
+	/// first gives it back its own copy of the style, the others keep sharing it.
+	////////////////////////////////////////////////////////////
+	BasicButton& set_style(std::shared_ptr<style_t const>);
+	[[nodiscard]] std::shared_ptr<style_t const> const& get_style()const noexcept { return m_cold->style; }
 
 	void change_default_color(sf::Color const&);
 	void set_texture(sf::Texture const&);
@@ -90,15 +180,489 @@ private:
 	void deselect();
 	void activate();
 	void desactivate();
+	void set_state(std::uint8_t);
+	void detach_style();
+	void draw_visible(sf::RenderWindow&, sf::FloatRect const&, CullStats&)const;
 
-	shape_t m_shapes;
-	sf::Text m_text;
-	std::function<void()>m_click{};
-	std::array<sf::Color, 3> m_col{};
-	std::array<sf::Texture, 3> m_filepath{};
-	sf::Vector2f m_current_texture{};
+	template<class F, class S>
+	static decltype(auto) visit(F&& f, S&& shape)
+	{
+		if constexpr (sizeof...(Shapes) == 1)
+			return std::invoke(std::forward<F>(f), std::forward<S>(shape));
+		else
+			return std::visit(std::forward<F>(f), std::forward<S>(shape));
+	}
 
-	[[maybe_unused]] bool m_toggle{ false };
-	bool m_choose{ false };
+	template<class F>
+	decltype(auto) modify_shape(F&& f)
+	{
+		detach_style();
+		return visit(std::forward<F>(f), m_cold->look->shape);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// Everything hit-testing and culling read, kept inline in the node after the Container :
+	/// with g++ on x86-64 a Button is 80 B, 48 B of Container, this record at offset 48 and the pointer to the cold block.
+	/// A node is only 16 B aligned, so the 22 B read here straddle two cache lines for one node in four
+	////////////////////////////////////////////////////////////
+	struct Hot
+	{
+		sf::FloatRect bounds{};//global bounds of the shape, refreshed by every function moving it
+		bool choose{ false };
+		[[maybe_unused]] bool toggle{ false };
+		bool encloses_children{ false };
+		bool styled{ false };
+		bool stale{ true };//the look changed since set_state last applied the one of the state
+		std::uint8_t state{ 0 };//0 idle, 1 hovered, 2 pressed
+	};
+
+	////////////////////////////////////////////////////////////
+	/// What a button without style owns to draw itself
+	////////////////////////////////////////////////////////////
+	struct Look
+	{
+		shape_t shape{};
+		std::array<sf::Color, 3> col{};
+		std::shared_ptr<std::array<sf::Texture, 3> const> textures{};//never modified once shared, replaced as a whole
+		sf::Vector2f current_texture{};
+	};
+
+	////////////////////////////////////////////////////////////
+	/// Resources only drawing and state changes touch, allocated apart
+	////////////////////////////////////////////////////////////
+	struct Cold
+	{
+		std::unique_ptr<Look> look{ std::make_unique<Look>() };//nullptr while the button is styled
+		std::shared_ptr<style_t const> style{};
+		sf::Vector2f position{};//only used while styled, the own shape holds it otherwise
+		std::unique_ptr<sf::Text> text{};//only created by the text constructors and set_string
+		std::function<void()> click{};
+	};
+
+	static std::unique_ptr<Cold> make_cold(shape_t shape, sf::Text text)
+	{
+		//a default constructed sf::Text (no font, no string) means no label at all
+		auto label = text.getFont() || !text.getString().isEmpty() ? std::make_unique<sf::Text>(std::move(text)) : nullptr;
+		return std::unique_ptr<Cold>(new Cold{ std::unique_ptr<Look>(new Look{ std::move(shape) }), nullptr, {}, std::move(label) });
+	}
+	static std::unique_ptr<Cold> copy_cold(Cold const& other)
+	{
+		return std::unique_ptr<Cold>(new Cold{ other.look ? std::make_unique<Look>(*other.look) : nullptr, other.style, other.position,
+			other.text ? std::make_unique<sf::Text>(*other.text) : nullptr, other.click });
+	}
+	void refresh_bounds() noexcept;
+
+	Hot m_hot{};
+	std::unique_ptr<Cold> m_cold{ std::make_unique<Cold>() };
 };
-#endif
\ No newline at end of file
+
+////////////////////////////////////////////////////////////
+/// The button used everywhere in this project, instantiated once in Button.cpp
+////////////////////////////////////////////////////////////
+using Button = BasicButton<sf::RectangleShape, sf::CircleShape, sf::ConvexShape, sf::Sprite, RectPrimitive, RoundedRectPrimitive, CirclePrimitive>;
+
+extern template class BasicButton<sf::RectangleShape, sf::CircleShape, sf::ConvexShape, sf::Sprite, RectPrimitive, RoundedRectPrimitive, CirclePrimitive>;
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::create_function_call(std::function<void()> onClick)noexcept
+{
+	m_cold->click = std::move(onClick);
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::process_events(sf::Event const& e)
+{
+	const auto rect = get_globalbounds();
+
+	switch (e.type)
+	{
+	case sf::Event::MouseButtonPressed:
+		if (rect.contains(static_cast<float>(e.mouseButton.x), static_cast<float>(e.mouseButton.y)))
+			set_state(2);
+		break;
+	case sf::Event::MouseButtonReleased:
+		if (rect.contains(static_cast<float>(e.mouseButton.x), static_cast<float>(e.mouseButton.y)))
+		{
+			if (m_cold->click) {
+				m_cold->click();
+			}
+
+			desactivate();
+		}
+		break;
+	case sf::Event::MouseMoved:
+		if (rect.contains(static_cast<float>(e.mouseMove.x), static_cast<float>(e.mouseMove.y)))
+			select();
+		else
+			deselect();
+		break;
+	case sf::Event::JoystickButtonPressed:
+		switch (e.joystickButton.button) {
+		case 0:
+			if (rect.contains(sf::Vector2f(sf::Mouse::getPosition())))
+				set_state(2);
+			break;
+		default:
+			break;
+		}
+		break;
+	case sf::Event::JoystickButtonReleased:
+		switch (e.joystickButton.button)
+		{
+		case 0:
+			if (rect.contains(sf::Vector2f(sf::Mouse::getPosition())))
+			{
+				if (m_cold->click) {
+					m_cold->click();
+				}
+
+				desactivate();
+			}
+			break;
+		}
+		break;
+	default:
+		break;
+	}
+
+	//recursive call before the creation of the function "apply_foreach" in the base class
+	/*std::for_each(std::begin(get_childs()), std::end(get_childs()), [e](auto& h) {h.second->process_events(e); });*/
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::select()
+{
+	set_state(1);
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::deselect()
+{
+	set_state(0);
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::activate()
+{
+	set_state(2);
+	if (m_cold->click)
+		m_cold->click();
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::desactivate()
+{
+	set_state(1);
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::set_state(std::uint8_t state)
+{
+	//applying the same look again changes nothing : a mouse move far from a button doesn't read its cold block
+	if (state == m_hot.state && !m_hot.stale)
+		return;
+
+	m_hot.state = state;
+	if (m_hot.styled)
+		return;//the style already has a shape for every state
+
+	if (!m_hot.choose)
+		change_default_color(m_cold->look->col[state]);
+	else
+		set_texture((*m_cold->look->textures)[state]);
+	m_hot.stale = false;
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::draw(sf::RenderWindow& window)const
+{
+	sf::RenderStates states;
+	if (m_hot.styled)
+		states.transform.translate(m_cold->position);
+
+	visit_shape([&](auto&& args) {
+		if constexpr (requires { window.draw(args, states); })
+			window.draw(args, states);
+		else
+			args.draw(window, states);//primitives generate their geometry here
+		});
+	if (auto const* text = get_text())
+		window.draw(*text);
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::submit(ButtonBatch& batch)const
+{
+	batch.push(*this);
+}
+
+template<class ...Shapes>
+inline auto BasicButton<Shapes...>::draw_visible(sf::RenderWindow& window)const -> CullStats
+{
+	//the view maps the visible world to [-1, 1], its inverse gives back the visible world (bounding box if rotated)
+	const auto visible = window.getView().getInverseTransform().transformRect(sf::FloatRect(-1.f, -1.f, 2.f, 2.f));
+
+	CullStats stats;
+	draw_visible(window, visible, stats);
+	return stats;
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::draw_visible(sf::RenderWindow& window, sf::FloatRect const& visible, CullStats& stats)const
+{
+	if (get_globalbounds().intersects(visible) || (get_text() && get_text()->getGlobalBounds().intersects(visible)))
+	{
+		draw(window);
+		++stats.drawn;
+	}
+	else
+	{
+		++stats.culled;
+		if (m_hot.encloses_children)
+		{
+			++stats.culled_subtrees;
+			return;
+		}
+	}
+
+	this->for_each_child([&](BasicButton const& child) { child.draw_visible(window, visible, stats); });
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::set_texture(sf::Texture const& path)
+{
+	detach_style();
+	m_hot.choose = true;
+
+	//path may be one of the current textures : copy it before they are released
+	auto textures = std::make_shared<std::array<sf::Texture, 3>>();
+	std::ranges::fill(*textures, path);
+	m_cold->look->textures = textures;
+
+	modify_shape([&textures](auto&& args) { apply_texture(args, textures->front()); });
+
+	refresh_bounds();
+}
+
+template<class ...Shapes>
+inline BasicButton<Shapes...>& BasicButton<Shapes...>::set_color_state(sf::Color const& noMouseOn, sf::Color const& mouseMovedOn, sf::Color const& mouseClickedOn)
+{
+	detach_style();
+	m_hot.choose = false;
+	m_hot.stale = true;
+	std::get<0>(m_cold->look->col) = noMouseOn;
+	std::get<1>(m_cold->look->col) = mouseMovedOn;
+	std::get<2>(m_cold->look->col) = mouseClickedOn;
+	return *this;
+}
+
+template<class ...Shapes>
+inline BasicButton<Shapes...>& BasicButton<Shapes...>::set_texture_state(sf::Texture const& noMouseOn, sf::Texture const& mouseMovedOn, sf::Texture const& mouseClickedOn)
+{
+	detach_style();
+	m_hot.choose = true;
+	m_hot.stale = true;
+	m_cold->look->textures = std::make_shared<std::array<sf::Texture, 3> const>(std::array<sf::Texture, 3>{ noMouseOn, mouseMovedOn, mouseClickedOn });
+	return *this;
+}
+
+template<class ...Shapes>
+inline BasicButton<Shapes...>& BasicButton<Shapes...>::resize()
+{
+	detach_style();
+	if (m_hot.choose)
+	{
+		m_hot.stale = true;
+		modify_shape([this](auto&& args) {
+			using _Ty = std::remove_cvref_t<decltype(args)>;
+			const auto& size = m_cold->look->current_texture;
+			if constexpr (requires { args.setSize(size); })
+				args.setSize(size);
+			else if constexpr (requires { args.setRadius(size.x); })
+				args.setRadius(size.x);
+			else if constexpr (requires { args.setTextureRect(sf::IntRect()); })
+				args.setTextureRect(sf::IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y)));
+			else
+				static_assert(std::_Always_false<_Ty>, "Wrong type entered for resize of your Button");
+			});
+		refresh_bounds();
+	}
+
+	return *this;
+}
+
+template<class ...Shapes>
+inline BasicButton<Shapes...>& BasicButton<Shapes...>::set_encloses_children(bool encloses) noexcept
+{
+	m_hot.encloses_children = encloses;
+	return *this;
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::change_default_color(sf::Color const& col)
+{
+	detach_style();
+	m_hot.choose = false;
+
+	std::ranges::fill(m_cold->look->col, col);
+
+	modify_shape([&col](auto&& args) { apply_color(args, col); });
+}
+
+template<class ...Shapes>
+inline BasicButton<Shapes...>& BasicButton<Shapes...>::set_position(sf::Vector2f const& pos)
+{
+	if (m_hot.styled)
+	{
+		m_cold->position = pos;
+		return *this;
+	}
+
+	modify_shape([&](auto&& args) { args.setPosition(pos); });
+	refresh_bounds();
+	return *this;
+}
+
+template<class ...Shapes>
+inline BasicButton<Shapes...>& BasicButton<Shapes...>::set_origin()
+{
+	modify_shape([](auto&& args) { args.setOrigin(args.getGlobalBounds().width / 2.f, args.getGlobalBounds().height / 2.f); });
+	refresh_bounds();
+
+	return *this;
+}
+
+template<class ...Shapes>
+inline BasicButton<Shapes...>& BasicButton<Shapes...>::set_rotation(float rota)
+{
+	modify_shape([=](auto&& args) { args.setRotation(rota); });
+	refresh_bounds();
+
+	return *this;
+}
+
+template<class ...Shapes>
+inline BasicButton<Shapes...>& BasicButton<Shapes...>::set_string(std::string const& str)
+{
+	if (!m_cold->text)
+		m_cold->text = std::make_unique<sf::Text>();
+	m_cold->text->setString(str);
+
+	return *this;
+}
+
+template<class ...Shapes>
+inline bool BasicButton<Shapes...>::mouse_in_button(sf::RenderWindow const& window) const
+{
+	return get_globalbounds().contains(sf::Vector2f(sf::Mouse::getPosition(window)));
+}
+
+template<class ...Shapes>
+inline sf::Vector2f BasicButton<Shapes...>::get_position()const noexcept
+{
+	if (m_hot.styled)
+		return m_cold->position;
+
+	return visit_shape([](auto&& args) { return args.getPosition(); });
+}
+
+template<class ...Shapes>
+inline sf::Text const* BasicButton<Shapes...>::get_text()const
+{
+	//the label lives in the button, only the style knows its font and size : they are applied when the label is read
+	if (m_hot.styled && m_cold->text)
+		m_cold->style->style_label(*m_cold->text);
+	return m_cold->text.get();
+}
+
+template<class ...Shapes>
+inline sf::FloatRect BasicButton<Shapes...>::get_globalbounds()const noexcept
+{
+	if (!m_hot.styled)
+		return m_hot.bounds;
+
+	//read from the style every time, so changing the style moves no button
+	auto bounds = m_cold->style->get_bounds(m_hot.state);
+	bounds.left += m_cold->position.x;
+	bounds.top += m_cold->position.y;
+	return bounds;
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::refresh_bounds() noexcept
+{
+	if (!m_hot.styled)
+		m_hot.bounds = visit_shape([](auto&& args) {return args.getGlobalBounds(); });
+}
+
+template<class ...Shapes>
+inline BasicButton<Shapes...>& BasicButton<Shapes...>::set_style(std::shared_ptr<style_t const> style)
+{
+	if (!style)
+	{
+		detach_style();
+		return *this;
+	}
+
+	m_cold->position = get_position();
+	m_cold->style = std::move(style);
+	m_cold->look.reset();
+	m_hot.styled = true;
+	return *this;
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::detach_style()
+{
+	if (!m_hot.styled)
+		return;
+
+	auto const& style = *m_cold->style;
+	//the copied shape still points to the textures of the style, they are kept alive with it instead of being copied
+	auto look = std::unique_ptr<Look>(new Look{ style.get_shape(m_hot.state), style.get_colors(),
+		std::shared_ptr<std::array<sf::Texture, 3> const>(m_cold->style, &style.get_textures()) });
+	m_hot.choose = style.uses_textures();
+	visit([&](auto& shape) { shape.setPosition(m_cold->position); }, look->shape);
+
+	m_cold->look = std::move(look);
+	m_cold->style.reset();
+	m_hot.styled = false;
+	m_hot.stale = true;
+	refresh_bounds();
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::force_hover() noexcept
+{
+	select();
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::desactivate_hover() noexcept
+{
+	deselect();
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::force_activation() noexcept
+{
+	if (m_cold->click) {
+		//play your music here
+		m_cold->click();
+	}
+
+	desactivate();
+}
+
+template<class ...Shapes>
+inline void BasicButton<Shapes...>::center_text() noexcept
+{
+	if (!m_cold->text)
+		return;
+
+	auto rect = m_cold->text->getLocalBounds();
+	m_cold->text->setOrigin(rect.left + rect.width / 2.f, rect.top + rect.height / 2.f);
+	m_cold->text->setPosition(get_position());
+}
+
+#endif // !BUTTON_H
@@ -0,0 +1,263 @@
+#include "ButtonBatch.h"
+#include <algorithm>
+#include <future>
+
+void ButtonBatch::Transforms::push(sf::Transformable const& t, sf::Vector2f const& translation)
+{
+	//a translation applied after the transform of t only adds to its position
+	push(t.getPosition() + translation, t.getOrigin(), t.getRotation(), t.getScale());
+}
+
+void ButtonBatch::Transforms::push(sf::Vector2f const& position, sf::Vector2f const& origin, float angle, sf::Vector2f const& scale)
+{
+	position_x.push_back(position.x);
+	position_y.push_back(position.y);
+	origin_x.push_back(origin.x);
+	origin_y.push_back(origin.y);
+	rotation.push_back(angle);
+	scale_x.push_back(scale.x);
+	scale_y.push_back(scale.y);
+}
+
+void ButtonBatch::Transforms::clear() noexcept
+{
+	for (auto* column : { &position_x, &position_y, &origin_x, &origin_y, &rotation, &scale_x, &scale_y })
+		column->clear();
+}
+
+vertex_kernel::TransformSoA ButtonBatch::Transforms::view() const noexcept
+{
+	return { position_x, position_y, origin_x, origin_y, rotation, scale_x, scale_y };
+}
+
+void ButtonBatch::clear() noexcept
+{
+	m_quad_transforms.clear();
+	m_quad_width.clear();
+	m_quad_height.clear();
+	m_quad_color.clear();
+	m_quad_offset.clear();
+
+	m_circle_transforms.clear();
+	m_circle_radius.clear();
+	m_circle_points.clear();
+	m_circle_color.clear();
+	m_circle_offset.clear();
+
+	m_fans.clear();
+	m_watches.clear();
+	m_segments.clear();
+	m_vertices.clear();
+	m_vertex_end = 0;
+}
+
+bool ButtonBatch::is_watched(std::uint64_t const* key) const noexcept
+{
+	//few styles for many buttons, and styled buttons usually come in runs
+	return (!m_watches.empty() && m_watches.back().key == key) || std::ranges::find(m_watches, key, &Watch::key) != m_watches.end();
+}
+
+bool ButtonBatch::is_stale() const noexcept
+{
+	return std::ranges::any_of(m_watches, [](Watch const& w) {
+		const auto revision = w.revision.lock();
+		return !revision || *revision != w.seen;
+		});
+}
+
+void ButtonBatch::push_shape(sf::RectangleShape const& shape)
+{
+	if (shape.getTexture() || shape.getOutlineThickness() != 0.f)
+		return push_direct(shape);
+
+	m_quad_transforms.push(shape, m_translation);
+	m_quad_width.push_back(shape.getSize().x);
+	m_quad_height.push_back(shape.getSize().y);
+	m_quad_color.push_back(shape.getFillColor());
+	m_quad_offset.push_back(m_vertex_end);
+	m_vertex_end += vertex_kernel::quad_vertex_count;
+}
+
+void ButtonBatch::push_shape(sf::CircleShape const& shape)
+{
+	if (shape.getTexture() || shape.getOutlineThickness() != 0.f)
+		return push_direct(shape);
+
+	const auto points = static_cast<std::uint32_t>(shape.getPointCount());
+	m_circle_transforms.push(shape, m_translation);
+	m_circle_radius.push_back(shape.getRadius());
+	m_circle_points.push_back(points);
+	m_circle_color.push_back(shape.getFillColor());
+	m_circle_offset.push_back(m_vertex_end);
+	m_vertex_end += vertex_kernel::circle_vertex_count(points);
+}
+
+void ButtonBatch::push_shape(sf::Drawable const& drawable)
+{
+	push_direct(drawable);
+}
+
+void ButtonBatch::push_shape(RectPrimitive const& shape)
+{
+	if (shape.getTexture())
+		return push_fan(shape);
+
+	m_quad_transforms.push(shape.getPosition() + m_translation, shape.getOrigin(), shape.getRotation(), { 1.f, 1.f });
+	m_quad_width.push_back(shape.getSize().x);
+	m_quad_height.push_back(shape.getSize().y);
+	m_quad_color.push_back(shape.getFillColor());
+	m_quad_offset.push_back(m_vertex_end);
+	m_vertex_end += vertex_kernel::quad_vertex_count;
+}
+
+void ButtonBatch::push_shape(CirclePrimitive const& shape)
+{
+	if (shape.getTexture())
+		return push_fan(shape);
+
+	const auto points = shape.getPointCount();
+	m_circle_transforms.push(shape.getPosition() + m_translation, shape.getOrigin(), shape.getRotation(), { 1.f, 1.f });
+	m_circle_radius.push_back(shape.getRadius());
+	m_circle_points.push_back(points);
+	m_circle_color.push_back(shape.getFillColor());
+	m_circle_offset.push_back(m_vertex_end);
+	m_vertex_end += vertex_kernel::circle_vertex_count(points);
+}
+
+void ButtonBatch::push_textured(std::uint32_t vertex_begin, sf::Texture const* texture)
+{
+	//consecutive primitives with the same texture share one draw call
+	if (!m_segments.empty())
+	{
+		auto& last = m_segments.back();
+		if (!last.direct && last.texture == texture && last.resume == vertex_begin)
+		{
+			last.resume = m_vertex_end;
+			return;
+		}
+	}
+	m_segments.push_back({ vertex_begin, m_vertex_end, nullptr, texture, {} });
+}
+
+void ButtonBatch::push_label(sf::Text const* text)
+{
+	if (text && !text->getString().isEmpty())
+		push_direct(*text);
+}
+
+void ButtonBatch::push_direct(sf::Drawable const& drawable)
+{
+	m_segments.push_back({ m_vertex_end, m_vertex_end, &drawable, nullptr, m_translation });
+}
+
+void ButtonBatch::build()
+{
+	m_vertices.resize(m_vertex_end);
+
+	vertex_kernel::generate_quads({ m_quad_transforms.view(), m_quad_width, m_quad_height, m_quad_color, m_quad_offset }, m_vertices);
+	vertex_kernel::generate_circles({ m_circle_transforms.view(), m_circle_radius, m_circle_points, m_circle_color, m_circle_offset }, m_vertices);
+
+	for (auto const& [shape, write, offset, translation] : m_fans)
+		write(shape, std::span(m_vertices).subspan(offset), translation);
+}
+
+void ButtonBatch::build_nodes(void (*push_node)(ButtonBatch&, void const*), unsigned threads)
+{
+	const std::size_t chunk_count = std::clamp<std::size_t>(m_nodes.size() / min_nodes_per_chunk, 1, std::max(threads, 1u));
+	if (chunk_count == 1)
+	{
+		for (auto const* node : m_nodes)
+			push_node(*this, node);
+		build();
+		return;
+	}
+
+	m_chunks.resize(chunk_count);
+	const auto build_chunk = [this, chunk_count, push_node](std::size_t k) {
+		auto& chunk = m_chunks[k];
+		chunk.clear();
+		const std::size_t first = m_nodes.size() * k / chunk_count;
+		const std::size_t last = m_nodes.size() * (k + 1) / chunk_count;
+		for (std::size_t i = first; i < last; ++i)
+			push_node(chunk, m_nodes[i]);
+		chunk.build();
+	};
+
+	std::vector<std::future<void>> workers;
+	workers.reserve(chunk_count - 1);
+	for (std::size_t k = 1; k < chunk_count; ++k)
+		workers.push_back(std::async(std::launch::async, build_chunk, k));
+	build_chunk(0);
+	for (auto& w : workers)
+		w.get();
+
+	for (auto const& chunk : m_chunks)
+		append(chunk);
+}
+
+void ButtonBatch::append(ButtonBatch const& chunk)
+{
+	const auto base = static_cast<std::uint32_t>(m_vertices.size());
+	m_vertices.insert(m_vertices.end(), chunk.m_vertices.begin(), chunk.m_vertices.end());
+
+	//a textured run going on in the chunk is merged as push_textured would have done it
+	auto segments = std::span(chunk.m_segments);
+	if (!segments.empty() && !m_segments.empty())
+	{
+		auto& last = m_segments.back();
+		auto const& first = segments.front();
+		if (!first.direct && first.vertex_end == 0 && !last.direct && last.texture == first.texture && last.resume == base)
+		{
+			last.resume = base + first.resume;
+			segments = segments.subspan(1);
+		}
+	}
+	for (auto const& [end, resume, direct, texture, translation] : segments)
+		m_segments.push_back({ base + end, base + resume, direct, texture, translation });
+	m_vertex_end = static_cast<std::uint32_t>(m_vertices.size());
+
+	for (auto const& w : chunk.m_watches)
+		if (!is_watched(w.key))
+			m_watches.push_back(w);
+}
+
+void ButtonBatch::draw(sf::RenderTarget& target, sf::RenderStates const& states) const
+{
+	std::uint32_t begin = 0;
+	for (auto const& [end, resume, direct, texture, translation] : m_segments)
+	{
+		if (end > begin)
+			target.draw(m_vertices.data() + begin, end - begin, sf::Triangles, states);
+
+		if (direct && translation == sf::Vector2f())
+			target.draw(*direct, states);
+		else if (direct)
+		{
+			auto moved = states;
+			moved.transform.translate(translation);
+			target.draw(*direct, moved);
+		}
+		else
+		{
+			auto textured = states;
+			textured.texture = texture;
+			target.draw(m_vertices.data() + end, resume - end, sf::Triangles, textured);
+		}
+		begin = resume;
+	}
+
+	if (m_vertex_end > begin)
+		target.draw(m_vertices.data() + begin, m_vertex_end - begin, sf::Triangles, states);
+}
+
+std::size_t ButtonBatch::draw_call_count() const noexcept
+{
+	std::size_t count = m_segments.size();
+	std::uint32_t begin = 0;
+	for (auto const& s : m_segments)
+	{
+		count += s.vertex_end > begin;
+		begin = s.resume;
+	}
+	return count + (m_vertex_end > begin);
+}
@@ -0,0 +1,218 @@
+#ifndef BUTTONBATCH_H
+#define BUTTONBATCH_H
+
+#include "Primitives.h"
+#include "VertexKernel.h"
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "SFML/Graphics/CircleShape.hpp"
+#include "SFML/Graphics/Drawable.hpp"
+#include "SFML/Graphics/RectangleShape.hpp"
+#include "SFML/Graphics/RenderStates.hpp"
+#include "SFML/Graphics/RenderTarget.hpp"
+#include "SFML/Graphics/Text.hpp"
+#include "SFML/Graphics/Transformable.hpp"
+
+template<class ...Shapes>
+class BasicButton;
+
+////////////////////////////////////////////////////////////
+/// \brief Collects buttons and draws all their untextured rectangles and circles with as few draw calls as possible
+/// Example : ButtonBatch batch;
+/// parent.apply_foreach<&Button::submit>(batch);
+/// batch.build();
+/// batch.draw(window);
+///
+/// Shapes with a texture or an outline, sprites, convex shapes and labels are drawn one by one in between,
+/// so the result is the same as calling Button::draw in the same order.
+/// Primitives are always batched : the untextured ones with the other shapes,
+/// the textured ones in one draw call per run of consecutive primitives sharing a texture.
+/// The batch keeps pointers to the submitted buttons : clear it and submit again once they changed.
+////////////////////////////////////////////////////////////
+class ButtonBatch
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Forget every submitted button, keeps the memory for the next frame
+	////////////////////////////////////////////////////////////
+	void clear() noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the shape and the label of one button after everything already submitted
+	////////////////////////////////////////////////////////////
+	template<class ...Shapes>
+	void push(BasicButton<Shapes...> const&);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Generate the vertices of every batched shape
+	////////////////////////////////////////////////////////////
+	void build();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Clear the batch, then push the root and all its descendants in pre-order and build them
+	/// Example : batch.build_tree(parent);
+	///
+	/// The pre-order list is cut in contiguous chunks, each one is pushed and built by its own thread
+	/// into its own buffers, then the chunks are concatenated in order :
+	/// the draw stream is the same as with a single thread.
+	///
+	/// \param the maximum number of threads, small trees are always built on the calling thread
+	////////////////////////////////////////////////////////////
+	template<class ...Shapes>
+	void build_tree(BasicButton<Shapes...> const&, unsigned threads = std::thread::hardware_concurrency());
+
+	void draw(sf::RenderTarget&, sf::RenderStates const& = sf::RenderStates::Default) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Tell if a style used by a submitted button changed since it was submitted (theme switch...),
+	/// the batch then has to be cleared, filled and built again
+	/// Example : if (batch.is_stale()) batch.build_tree(parent);
+	///
+	/// Costs one comparison per style used, whatever the number of buttons.
+	/// A style destroyed since (detach_style, set_style(nullptr) on its last button...) makes the batch stale too
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] bool is_stale() const noexcept;
+
+	[[nodiscard]] std::size_t vertex_count() const noexcept { return m_vertices.size(); }
+	[[nodiscard]] std::size_t draw_call_count() const noexcept;
+
+private:
+
+	struct Transforms
+	{
+		std::vector<float> position_x, position_y, origin_x, origin_y, rotation, scale_x, scale_y;
+
+		void push(sf::Transformable const&, sf::Vector2f const& translation);
+		void push(sf::Vector2f const& position, sf::Vector2f const& origin, float rotation, sf::Vector2f const& scale);
+		void clear() noexcept;
+		[[nodiscard]] vertex_kernel::TransformSoA view() const noexcept;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// Vertices in [previous resume, vertex_end) are drawn in one call, then direct is drawn alone,
+	/// or without direct the vertices in [vertex_end, resume) are drawn with texture
+	////////////////////////////////////////////////////////////
+	struct Segment
+	{
+		std::uint32_t vertex_end;
+		std::uint32_t resume;
+		sf::Drawable const* direct;
+		sf::Texture const* texture;
+		sf::Vector2f translation;//moves direct, shapes of styled buttons are stored at (0, 0)
+	};
+
+	////////////////////////////////////////////////////////////
+	/// A primitive generated by build() at offset, whatever its type
+	////////////////////////////////////////////////////////////
+	struct Fan
+	{
+		void const* shape;
+		void (*write)(void const*, std::span<sf::Vertex>, sf::Vector2f const&);
+		std::uint32_t offset;
+		sf::Vector2f translation;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// The revision of a style when the first of its buttons was pushed
+	////////////////////////////////////////////////////////////
+	struct Watch
+	{
+		std::uint64_t const* key;//tells the styles apart, only read through revision
+		std::weak_ptr<std::uint64_t const> revision;//shares the ownership of the style
+		std::uint64_t seen;
+	};
+
+	[[nodiscard]] bool is_watched(std::uint64_t const* key) const noexcept;
+	void push_shape(sf::RectangleShape const&);
+	void push_shape(sf::CircleShape const&);
+	void push_shape(sf::Drawable const&);
+	void push_shape(RectPrimitive const&);
+	void push_shape(CirclePrimitive const&);
+	template<class _Ty>
+	void push_shape(Primitive<_Ty> const&);
+	template<class _Ty>
+	void push_fan(_Ty const&);
+	void push_textured(std::uint32_t vertex_begin, sf::Texture const*);
+	void push_label(sf::Text const*);
+	void push_direct(sf::Drawable const&);
+	void build_nodes(void (*push_node)(ButtonBatch&, void const*), unsigned threads);
+	void append(ButtonBatch const&);
+
+	static constexpr std::size_t min_nodes_per_chunk{ 2048 };
+
+	Transforms m_quad_transforms;
+	std::vector<float> m_quad_width, m_quad_height;
+	std::vector<sf::Color> m_quad_color;
+	std::vector<std::uint32_t> m_quad_offset;
+
+	Transforms m_circle_transforms;
+	std::vector<float> m_circle_radius;
+	std::vector<std::uint32_t> m_circle_points;
+	std::vector<sf::Color> m_circle_color;
+	std::vector<std::uint32_t> m_circle_offset;
+
+	std::vector<Fan> m_fans;
+	sf::Vector2f m_translation{};//get_shape_translation() of the button being pushed
+	std::vector<Watch> m_watches;
+
+	std::vector<Segment> m_segments;
+	std::vector<sf::Vertex> m_vertices;
+	std::uint32_t m_vertex_end{ 0 };
+
+	std::vector<void const*> m_nodes;//the nodes of build_tree, whatever their shape types
+	std::vector<ButtonBatch> m_chunks;
+};
+
+template<class ...Shapes>
+inline void ButtonBatch::push(BasicButton<Shapes...> const& button)
+{
+	//the shared pointer is only made for the first button of a style, not to hit its counter from every thread
+	if (auto const& style = button.get_style(); style && !is_watched(&style->revision()))
+		m_watches.push_back({ &style->revision(), std::shared_ptr<std::uint64_t const>(style, &style->revision()), style->revision() });
+
+	m_translation = button.get_shape_translation();
+	button.visit_shape([this](auto const& shape) { push_shape(shape); });
+	m_translation = {};
+	push_label(button.get_text());
+}
+
+template<class _Ty>
+inline void ButtonBatch::push_shape(Primitive<_Ty> const& shape)
+{
+	push_fan(static_cast<_Ty const&>(shape));
+}
+
+template<class _Ty>
+inline void ButtonBatch::push_fan(_Ty const& shape)
+{
+	const std::uint32_t begin = m_vertex_end;
+	const auto write = [](void const* s, std::span<sf::Vertex> out, sf::Vector2f const& translation) {
+		auto const& fan = *static_cast<_Ty const*>(s);
+		fan.write_triangles(out);
+		if (translation != sf::Vector2f())
+			for (auto& v : out.first(fan.triangle_vertex_count()))
+				v.position += translation;
+	};
+	m_fans.push_back({ &shape, write, begin, m_translation });
+	m_vertex_end += shape.triangle_vertex_count();
+
+	if (shape.getTexture())
+		push_textured(begin, shape.getTexture());
+}
+
+template<class ...Shapes>
+inline void ButtonBatch::build_tree(BasicButton<Shapes...> const& root, unsigned threads)
+{
+	using node_t = BasicButton<Shapes...>;
+
+	clear();
+	m_nodes.clear();
+	root.visit_preorder([this](node_t const& b) { m_nodes.push_back(&b); });
+
+	build_nodes([](ButtonBatch& batch, void const* node) { batch.push(*static_cast<node_t const*>(node)); }, threads);
+}
+
+#endif
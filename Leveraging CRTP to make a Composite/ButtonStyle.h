@@ -0,0 +1,201 @@
+#ifndef BUTTONSTYLE_H
+#define BUTTONSTYLE_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include "SFML/Graphics/Color.hpp"
+#include "SFML/Graphics/Font.hpp"
+#include "SFML/Graphics/Rect.hpp"
+#include "SFML/Graphics/Text.hpp"
+#include "SFML/Graphics/Texture.hpp"
+
+////////////////////////////////////////////////////////////
+/// \brief Give a fill color to any shape of a button (setFillColor or setColor)
+////////////////////////////////////////////////////////////
+template<class _Ty>
+inline void apply_color(_Ty& shape, sf::Color const& col)
+{
+	if constexpr (requires { shape.setFillColor(col); })
+		shape.setFillColor(col);
+	else if constexpr (requires { shape.setColor(col); })
+		shape.setColor(col);
+	else
+		static_assert(std::_Always_false<_Ty>, "Wrong type entered for change_default_color of your Button");
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Give a texture to any shape of a button (setTexture taking a pointer or a reference)
+////////////////////////////////////////////////////////////
+template<class _Ty>
+inline void apply_texture(_Ty& shape, sf::Texture const& texture)
+{
+	if constexpr (requires { shape.setTexture(&texture); })
+		shape.setTexture(&texture);
+	else if constexpr (requires { shape.setTexture(texture); })
+		shape.setTexture(texture);
+	else
+		static_assert(std::_Always_false<_Ty>, "Wrong type entered for setTexture of your Button");
+}
+
+////////////////////////////////////////////////////////////
+/// \brief The geometry, palette and textures of many buttons, stored once
+/// Example : auto style = std::make_shared<Button::style_t>(sf::RectangleShape({ 64.f, 64.f }));
+/// style->set_color_state(sf::Color::White, sf::Color::Yellow, sf::Color::Red);
+/// for (...) parent.add(id).set_style(style).set_position(pos);
+///
+/// The style keeps one ready-made shape per state (idle, hovered, pressed) placed at (0, 0),
+/// a styled button only keeps its position and state and draws the shape of its state moved to its position.
+/// Buttons see the style as immutable : every change made through the owner of the style
+/// shows on all of them at the next frame, none of them is visited.
+/// Styles are shared through std::shared_ptr and can't be copied, their shapes point to their own textures.
+////////////////////////////////////////////////////////////
+template<class ...Shapes>
+class BasicStyle
+{
+public:
+	using shape_t = std::conditional_t<sizeof...(Shapes) == 1, std::tuple_element_t<0, std::tuple<Shapes...>>, std::variant<Shapes...>>;
+
+	explicit BasicStyle(shape_t const& shape) : m_shape{ shape }, m_states{ m_shape, m_shape, m_shape } { rebuild(); }
+
+	BasicStyle(BasicStyle const&) = delete;
+	BasicStyle& operator=(BasicStyle const&) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Replace the geometry, its position is ignored
+	////////////////////////////////////////////////////////////
+	BasicStyle& set_shape(shape_t const&);
+	BasicStyle& set_color_state(sf::Color const&, sf::Color const&, sf::Color const&);
+	BasicStyle& set_texture_state(sf::Texture const&, sf::Texture const&, sf::Texture const&);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Font and character size of the labels of the styled buttons, nullptr and 0 leave the labels as they are
+	////////////////////////////////////////////////////////////
+	BasicStyle& set_font(sf::Font const*) noexcept;
+	BasicStyle& set_text_size(unsigned) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Give the font and the size of the style to a label, nothing is recomputed when they already match
+	////////////////////////////////////////////////////////////
+	void style_label(sf::Text&)const;
+
+	////////////////////////////////////////////////////////////
+	/// \param the state of the button : 0 idle, 1 hovered, 2 pressed
+	///
+	/// \return The shape drawn for this state, at (0, 0)
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] shape_t const& get_shape(std::uint8_t state)const noexcept { return m_states[state]; }
+
+	////////////////////////////////////////////////////////////
+	/// \return The global bounds of get_shape(state), to offset by the position of a button
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] sf::FloatRect const& get_bounds(std::uint8_t state)const noexcept { return m_bounds[state]; }
+
+	[[nodiscard]] std::array<sf::Color, 3> const& get_colors()const noexcept { return m_col; }
+	[[nodiscard]] std::array<sf::Texture, 3> const& get_textures()const noexcept { return m_textures; }
+	[[nodiscard]] bool uses_textures()const noexcept { return m_choose; }
+	[[nodiscard]] sf::Font const* get_font()const noexcept { return m_font; }
+	[[nodiscard]] unsigned get_text_size()const noexcept { return m_text_size; }
+
+	////////////////////////////////////////////////////////////
+	/// \return A counter increased by every change of the style, what ButtonBatch::is_stale compares
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] std::uint64_t const& revision()const noexcept { return m_revision; }
+
+private:
+	template<class F, class S>
+	static decltype(auto) visit(F&& f, S&& shape)
+	{
+		if constexpr (sizeof...(Shapes) == 1)
+			return std::invoke(std::forward<F>(f), std::forward<S>(shape));
+		else
+			return std::visit(std::forward<F>(f), std::forward<S>(shape));
+	}
+
+	void rebuild();
+
+	shape_t m_shape;
+	std::array<shape_t, 3> m_states;
+	std::array<sf::FloatRect, 3> m_bounds{};
+	std::array<sf::Color, 3> m_col{ sf::Color::White, sf::Color::White, sf::Color::White };
+	std::array<sf::Texture, 3> m_textures{};
+	sf::Font const* m_font{ nullptr };
+	unsigned m_text_size{ 0 };
+	bool m_choose{ false };
+	std::uint64_t m_revision{ 0 };
+};
+
+template<class ...Shapes>
+inline BasicStyle<Shapes...>& BasicStyle<Shapes...>::set_shape(shape_t const& shape)
+{
+	m_shape = shape;
+	rebuild();
+	return *this;
+}
+
+template<class ...Shapes>
+inline BasicStyle<Shapes...>& BasicStyle<Shapes...>::set_color_state(sf::Color const& noMouseOn, sf::Color const& mouseMovedOn, sf::Color const& mouseClickedOn)
+{
+	m_choose = false;
+	m_col = { noMouseOn, mouseMovedOn, mouseClickedOn };
+	rebuild();
+	return *this;
+}
+
+template<class ...Shapes>
+inline BasicStyle<Shapes...>& BasicStyle<Shapes...>::set_texture_state(sf::Texture const& noMouseOn, sf::Texture const& mouseMovedOn, sf::Texture const& mouseClickedOn)
+{
+	m_choose = true;
+	m_textures = { noMouseOn, mouseMovedOn, mouseClickedOn };
+	rebuild();
+	return *this;
+}
+
+template<class ...Shapes>
+inline BasicStyle<Shapes...>& BasicStyle<Shapes...>::set_font(sf::Font const* font) noexcept
+{
+	m_font = font;
+	++m_revision;
+	return *this;
+}
+
+template<class ...Shapes>
+inline BasicStyle<Shapes...>& BasicStyle<Shapes...>::set_text_size(unsigned size) noexcept
+{
+	m_text_size = size;
+	++m_revision;
+	return *this;
+}
+
+template<class ...Shapes>
+inline void BasicStyle<Shapes...>::style_label(sf::Text& label)const
+{
+	//both setters of sf::Text return early when the value doesn't change
+	if (m_font)
+		label.setFont(*m_font);
+	if (m_text_size)
+		label.setCharacterSize(m_text_size);
+}
+
+template<class ...Shapes>
+inline void BasicStyle<Shapes...>::rebuild()
+{
+	++m_revision;
+	for (std::uint8_t state = 0; state < 3; ++state)
+	{
+		m_states[state] = m_shape;
+		visit([this, state](auto& shape) {
+			shape.setPosition(0.f, 0.f);
+			if (m_choose)
+				apply_texture(shape, m_textures[state]);
+			else
+				apply_color(shape, m_col[state]);
+			m_bounds[state] = shape.getGlobalBounds();
+			}, m_states[state]);
+	}
+}
+
+#endif
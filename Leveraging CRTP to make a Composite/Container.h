@@ -4,14 +4,55 @@
 #include <stdexcept>
 #include <memory>
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
 #include <vector>
 #include <ranges>
+#include <string>
+#include <string_view>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include "IdPool.h"
+#include "PerfectHash.h"
 
-template<class _Ty>
+////////////////////////////////////////////////////////////
+/// \brief Children keyed by ids (the default, _Key = Symbol) or by the enumerators of an enum class,
+/// see the specialization below
+////////////////////////////////////////////////////////////
+template<class _Ty, class _Key = Symbol>
 class Container
 {
+	static_assert(std::is_same_v<_Key, Symbol>, "The key of a Container is Symbol (string ids) or an enum class with a count enumerator");
+
 public:
 
+	////////////////////////////////////////////////////////////
+	/// \brief A child that can be kept across frames : resolve gives it back, or nullptr once it is removed
+	////////////////////////////////////////////////////////////
+	struct Handle
+	{
+		std::uint32_t index{ 0 };
+		std::uint32_t generation{ 0 };//0 is never given, a default Handle resolves to nullptr
+
+		friend constexpr bool operator==(Handle, Handle) noexcept = default;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief How my children are kept, nothing is spent on the second way until it is chosen :
+	/// - insertion (the default) : my storage is in the order of my siblings. get compares every id,
+	/// remove, detach and the functions moving a child shift the children in between : O(n)
+	/// - unordered : the positions of the ids are indexed and a sibling list (two slots per child, kept by me) gives the order,
+	/// get with a Symbol, remove, detach and the functions moving a child are O(1), my last stored child filling a hole.
+	/// get with a repeated id gives the first of its siblings with it, with Order::unordered any of them.
+	/// find_path gives the same child as a walk of get, with or without the index of paths
+	////////////////////////////////////////////////////////////
+	enum class Order : std::uint8_t { insertion, unordered };
+
 	explicit constexpr Container(_Ty* __p = nullptr) noexcept :m_parent(__p) {}
 
 	////////////////////////////////////////////////////////////
@@ -25,6 +66,194 @@ public:
 	////////////////////////////////////////////////////////////
 	template<class ...Args>
 	[[nodiscard]] constexpr auto& add(std::string_view, Args && ...args) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Same as add with an id already interned, nothing is hashed
+	/// Example : const Symbol cell = IdPool::shared().intern("cell");
+	/// for (...) row.add(cell, parameters...);
+	////////////////////////////////////////////////////////////
+	template<class ...Args>
+	[[nodiscard]] constexpr auto& add(Symbol, Args && ...args) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Same as add with an id hashed at compile time, its characters are only read the first time the pool sees it
+	/// Example : Button& child = base.add("my_id"_id, parameters...);
+	////////////////////////////////////////////////////////////
+	template<class ...Args>
+	[[nodiscard]] constexpr auto& add(HashedId, Args && ...args) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add every element of a range, each one being a tuple (id, parameters...) given to add
+	/// Example : std::vector<std::tuple<std::string, sf::RectangleShape>> cells = ...;
+	/// base.add_range(cells);
+	///
+	/// My container grows once when the size of the range is known, elements of an rvalue range are moved
+	////////////////////////////////////////////////////////////
+	template<std::ranges::input_range R>
+	constexpr void add_range(R&& entries);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Same as add, returning a handle of the new child instead of a reference
+	/// Example : const auto score = hud.add_handle("score"_id, parameters...);
+	/// if (Button* b = hud.resolve(score)) b->set_position(pos);//every frame, the child may be gone
+	////////////////////////////////////////////////////////////
+	template<class Id, class ...Args>
+	[[nodiscard]] constexpr Handle add_handle(Id&& id, Args && ...args) { return handle_of(add(std::forward<Id>(id), std::forward<Args>(args)...)); }
+
+	////////////////////////////////////////////////////////////
+	/// \return The handle of one of my children, always the same one for a given child, or throw an exception
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] constexpr Handle handle_of(_Ty const& child);
+
+	////////////////////////////////////////////////////////////
+	/// \return The child of a handle given by my container, nullptr once it has been removed. O(1)
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] constexpr _Ty* resolve(Handle) const noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Index the paths of all my descendants, kept up to date by add and remove : only a root can have one
+	/// Example : root.index_paths();
+	/// Button* b = root.find_path("child2Name/childOfchild1");
+	///
+	/// \param false drops the index
+	////////////////////////////////////////////////////////////
+	void index_paths(bool enable = true);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find a descendant by the ids leading to it from me, separated by '/'
+	///
+	/// An indexed root answers with one hash lookup, any other node follows the path one get at a time
+	///
+	/// \return the descendant or nullptr
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] _Ty* find_path(std::string_view) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Index the ids of my children by their segments separated by '.', kept up to date by add and remove
+	/// Example : menu.index_prefixes();
+	/// menu.for_each_prefix("menu.audio", [](Button& b) { b.set_color_state(...); });
+	/// menu.remove_prefix("menu.video");
+	///
+	/// A prefix is made of whole segments : "menu.audio" matches "menu.audio" and "menu.audio.volume_up", not "menu.audiobook".
+	/// Without the index the prefix operations read every id of my children.
+	///
+	/// \param false drops the index
+	////////////////////////////////////////////////////////////
+	void index_prefixes(bool enable = true);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Call a function on every child whose id starts with the prefix, in no particular order
+	///
+	/// \param the prefix and a callable taking a reference to my derived class, which must not add or remove my children
+	////////////////////////////////////////////////////////////
+	template<class F>
+	void for_each_prefix(std::string_view, F&& f) const;
+
+	////////////////////////////////////////////////////////////
+	/// \return The number of my children whose id starts with the prefix, O(number of segments) with the index
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] std::size_t count_prefix(std::string_view) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove every child whose id starts with the prefix, my container is compacted once
+	////////////////////////////////////////////////////////////
+	void remove_prefix(std::string_view);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Freeze the ids of my children and of all my descendants' children in minimal perfect hash tables
+	/// Example : root.seal();//once the screen is built
+	/// root.get("child2Name"_id);//one pilot and one slot read, no IdPool lookup
+	///
+	/// Any add or remove on a container drops its table, get goes back to the IdPool and to comparing symbols
+	////////////////////////////////////////////////////////////
+	void seal();
+	[[nodiscard]] bool is_sealed() const noexcept { return sealed_table() != nullptr; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Choose how my children are kept, see Order
+	/// Example : notifications.set_order(Order::unordered);//spawned and despawned all the time
+	///
+	/// Order::unordered indexes the position of every id and links my children, back to Order::insertion my storage is sorted
+	/// in the order of my siblings : O(n) either way, the order of my siblings is kept
+	////////////////////////////////////////////////////////////
+	void set_order(Order);
+	[[nodiscard]] Order get_order() const noexcept { return position_index() ? Order::unordered : Order::insertion; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Call a function on each of my children in the order of my siblings : the order they are drawn,
+	/// add puts a child last, the functions below move them (in O(1) with Order::unordered)
+	/// Example : panel.for_each_child([](Button& b) { ... });
+	///
+	/// \param a callable taking a reference to my derived class, which must not add or remove my children
+	////////////////////////////////////////////////////////////
+	template<class F>
+	void for_each_child(F&& f) const;
+
+	[[nodiscard]] _Ty* first_child() const noexcept;
+	[[nodiscard]] _Ty* last_child() const noexcept;
+	[[nodiscard]] _Ty* next_sibling() const noexcept { return m_parent ? m_parent->sibling_after(m_slot) : nullptr; }
+	[[nodiscard]] _Ty* prev_sibling() const noexcept { return m_parent ? m_parent->sibling_before(m_slot) : nullptr; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move one of my children just before or just after another one, throw an exception if one of them isn't my child
+	/// Example : panel.insert_after(dialog, backdrop);//dialog drawn over backdrop
+	///
+	/// O(1) with Order::unordered, otherwise the children stored between the two places shift by one
+	////////////////////////////////////////////////////////////
+	void insert_before(_Ty& child, _Ty const& sibling);
+	void insert_after(_Ty& child, _Ty const& sibling);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move one of my children first (drawn under all its siblings) or last (drawn over them)
+	////////////////////////////////////////////////////////////
+	void move_to_front(_Ty& child);
+	void move_to_back(_Ty& child);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Take one of my children out of my container, with its descendants
+	/// Example : std::unique_ptr<Button> popup = panel.detach(panel.get("popup"_id));
+	///
+	/// O(1) with Order::unordered, otherwise the children stored after it shift down
+	///
+	/// \return the child, now a root : its id, its handle and its entries in the indices of my tree are dropped
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] std::unique_ptr<_Ty> detach(_Ty& child);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Give one of my children, with its id and its descendants, to another node : it is placed last among its new siblings
+	/// Example : Button& panel = left_dock.move_child("inventory"_id, right_dock);
+	///
+	/// Nothing is copied or reallocated, only the storage, the ids and the indices of the two containers are updated.
+	/// Its handle from me stops resolving, the new parent gives another one.
+	/// O(1) with Order::unordered : finding the child is a get and taking it out a detach, otherwise both are O(n)
+	///
+	/// \return the child moved, or throw an exception if I have no child with this id or if the new parent is the child or one of its descendants
+	////////////////////////////////////////////////////////////
+	_Ty& move_child(std::string_view, _Ty& new_parent);
+	_Ty& move_child(Symbol, _Ty& new_parent);
+	_Ty& move_child(HashedId, _Ty& new_parent);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Same as move_child with the child rather than its id, nothing is looked up : only taking it out costs O(n) with Order::insertion
+	/// Example : Button& row = spare.move_child(*parked_row, list);
+	////////////////////////////////////////////////////////////
+	_Ty& move_child(_Ty& child, _Ty& new_parent);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Give a range of my children to another node (or to me, to reorder them), keeping their order
+	/// Example : toolbar.splice(toolbar.get("cut"_id), toolbar.get("paste"_id), menu, &menu.get("quit"_id));
+	///
+	/// O(size of the range) with Order::unordered, otherwise the children stored after the range and after the place it goes to shift once
+	///
+	/// \param the first and the last child of the range in the order of my siblings, the new parent
+	/// and the child of the new parent to put them before, nullptr to put them last
+	////////////////////////////////////////////////////////////
+	void splice(_Ty& first, _Ty& last, _Ty& new_parent, _Ty const* before = nullptr);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Make room for n children in total, the next adds don't reallocate my container
+	////////////////////////////////////////////////////////////
+	constexpr void reserve(std::size_t n) { m_children.reserve(n); }
 	
 	////////////////////////////////////////////////////////////
 	/// \brief Give you the access to a derived object in your container
@@ -34,13 +263,55 @@ public:
 	/// \return a reference to the object corresponding to the id you gave or throw an exception 
 	////////////////////////////////////////////////////////////
 	[[nodiscard]] constexpr auto& get(std::string_view) const;
+	[[nodiscard]] constexpr auto& get(Symbol) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Same as get without any string work : a lookup of the hash in the pool then integer compares
+	/// Example : base.get("my_id"_id).set_position(pos);
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] constexpr auto& get(HashedId) const;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Remove the object corresponding to the id you gave
+	///
+	/// O(1) with Order::unordered : the position of the id is indexed and my last child takes its place
+	/// Can throw std::bad_alloc : compacting and indexing the path of a sibling with the same id allocate
 	/// 
 	/// \param the id of your object
 	////////////////////////////////////////////////////////////
-	constexpr void remove(std::string_view) noexcept;
+	constexpr void remove(std::string_view);
+	constexpr void remove(Symbol);
+	constexpr void remove(HashedId);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove all the objects corresponding to these ids, my container is compacted once
+	/// Example : std::array<std::string_view, 3> ids{ "a", "b", "c" };
+	/// base.remove(ids);//not base.remove({ "a", "b" }) which is a single std::string_view made of two pointers
+	////////////////////////////////////////////////////////////
+	void remove(std::span<const std::string_view>);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove every child satisfying a predicate, my container is compacted once
+	/// Example : base.remove_if([](Button const& b) { return b.get_position().y > 1080.f; });
+	///
+	/// \param a callable taking a const reference to my derived class, or its id and the const reference
+	////////////////////////////////////////////////////////////
+	template<class P>
+	void remove_if(P&& pred);
+
+	////////////////////////////////////////////////////////////
+	/// \brief remove_if on my container and on the containers of all my descendants kept, in one sweep :
+	/// a removed descendant takes its own descendants with it without them being tested
+	///
+	/// \param same as remove_if
+	////////////////////////////////////////////////////////////
+	template<class P>
+	void remove_descendants_if(P&& pred);
+
+	////////////////////////////////////////////////////////////
+	/// \return The id of a child, interned in IdPool::shared()
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] static std::string_view id_of(Symbol s) { return IdPool::shared().name(s); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Remove all elements of my container, the derived objects
@@ -56,15 +327,45 @@ public:
 	template<auto Func, class ...Args>
 	constexpr void apply_foreach(Args &&... args) noexcept;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Call a function on the base object and then on all its descendants, every parent before its children
+	/// Example : base.visit_preorder([](Button const& b) { ... });
+	///
+	/// \param a callable taking a const reference to my derived class
+	////////////////////////////////////////////////////////////
+	template<class F>
+	constexpr void visit_preorder(F&& f) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Deep copy of my derived object and all its descendants, every node being copied by _Ty(_Ty* parent, _Ty const& prototype)
+	/// Example : std::unique_ptr<Button> copy = card.clone();
+	///
+	/// \return the root of the copy, without parent
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] constexpr std::unique_ptr<_Ty> clone() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add n deep copies of a prototype subtree to my container, with the ids prefix0, prefix1... prefix(n-1)
+	/// Example : base.instantiate("card", card, 500, [](Button& c, std::size_t i) { c.set_position(...); });
+	///
+	/// My container grows once for the n copies and every copied container is allocated to its exact size
+	///
+	/// \param the prefix of the ids, the prototype (any node, even one of my descendants), the number of copies
+	/// and a callable taking each copy and its index once it is built
+	////////////////////////////////////////////////////////////
+	template<class F>
+	constexpr void instantiate(std::string_view, _Ty const&, std::size_t, F&& init);
+	constexpr void instantiate(std::string_view prefix, _Ty const& prototype, std::size_t n) { instantiate(prefix, prototype, n, [](_Ty&, std::size_t) {}); }
+
 protected:
 
 	~Container() = default;
 
 	////////////////////////////////////////////////////////////
-	/// \return Access to an editable view of the container
+	/// \return Access to an editable view of the container, in the order of storage : for_each_child gives the order of the siblings
 	////////////////////////////////////////////////////////////
 	[[nodiscard]] constexpr auto get_childs() const noexcept -> 
-		std::span<std::pair<std::string,std::unique_ptr<_Ty>>const > { return m_children; }
+		std::span<std::pair<Symbol,std::unique_ptr<_Ty>>const > { return m_children; }
 
 	////////////////////////////////////////////////////////////
 	/// \return Access to the button base
@@ -72,54 +373,1565 @@ protected:
 	[[nodiscard]] constexpr _Ty* get_parent()noexcept { return m_parent; }
 
 private:
+	////////////////////////////////////////////////////////////
+	/// The children having a handle, a removed child leaves its slot to the next one with a greater generation
+	////////////////////////////////////////////////////////////
+	struct HandleTable
+	{
+		struct Slot
+		{
+			_Ty* node;
+			std::uint32_t generation;
+		};
+
+		std::vector<Slot> slots;
+		std::vector<std::uint32_t> free;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// Every indexed descendant of a root by its path, and the path of each one to extend it on add
+	////////////////////////////////////////////////////////////
+	struct PathIndex
+	{
+		struct Hash
+		{
+			using is_transparent = void;
+			std::size_t operator()(std::string_view path)const noexcept { return std::hash<std::string_view>{}(path); }
+		};
+
+		std::unordered_map<std::string, _Ty*, Hash, std::equal_to<>> by_path;
+		std::unordered_map<_Ty const*, std::string_view> by_node;//views of the keys of by_path
+	};
+
+	////////////////////////////////////////////////////////////
+	/// The ids of my children cut at every '.', one node per segment : a node knows the children whose id ends there
+	/// and how many ids end at it or below it. A node no id goes through any more is pruned, the next adds reuse it
+	////////////////////////////////////////////////////////////
+	struct PrefixTrie
+	{
+		struct Node
+		{
+			std::unordered_map<std::uint32_t, std::uint32_t> next;//symbol of the segment to index of the node
+			std::vector<_Ty*> ends;
+			std::uint32_t count{ 0 };
+		};
+
+		std::deque<Node> nodes{ 1 };//a deque never moves the nodes as it grows
+		std::vector<std::uint32_t> free;
+	};
+
+	using Positions = std::unordered_multimap<std::uint32_t, std::uint32_t>;//symbol to position in m_children
+
+	////////////////////////////////////////////////////////////
+	/// The order of my siblings once my storage isn't in it : the previous and the next slot of each slot of m_children
+	////////////////////////////////////////////////////////////
+	struct SiblingList
+	{
+		struct Link
+		{
+			std::uint32_t prev;
+			std::uint32_t next;
+		};
+
+		std::vector<Link> links;
+		std::uint32_t first{ no_slot };
+		std::uint32_t last{ no_slot };
+	};
+
+	////////////////////////////////////////////////////////////
+	/// The indices a node may have, behind a single pointer : a node without any only pays for that pointer
+	////////////////////////////////////////////////////////////
+	struct Indices
+	{
+		std::unique_ptr<HandleTable> handles;//created by the first handle_of, copies don't get one
+		std::unique_ptr<PathIndex> paths;//roots only, created by index_paths
+		std::unique_ptr<PrefixTrie> prefixes;//created by index_prefixes
+		std::unique_ptr<PerfectHash<_Ty>> sealed;//fnv1a of the ids, created by seal and dropped by any change of my children
+		std::unique_ptr<Positions> positions;//Order::unordered only
+		std::unique_ptr<SiblingList> siblings;//Order::unordered only
+	};
+
+	[[nodiscard]] Indices& indices() { return m_indices ? *m_indices : *(m_indices = std::make_unique<Indices>()); }
+	[[nodiscard]] HandleTable* handle_table() const noexcept { return m_indices ? m_indices->handles.get() : nullptr; }
+	[[nodiscard]] PathIndex* path_index() const noexcept { return m_indices ? m_indices->paths.get() : nullptr; }
+	[[nodiscard]] PrefixTrie* prefix_trie() const noexcept { return m_indices ? m_indices->prefixes.get() : nullptr; }
+	[[nodiscard]] PerfectHash<_Ty>* sealed_table() const noexcept { return m_indices ? m_indices->sealed.get() : nullptr; }
+	[[nodiscard]] Positions* position_index() const noexcept { return m_indices ? m_indices->positions.get() : nullptr; }
+	[[nodiscard]] SiblingList* sibling_list() const noexcept { return m_indices ? m_indices->siblings.get() : nullptr; }
+	constexpr void unseal() noexcept
+	{
+		if (m_indices)
+			m_indices->sealed.reset();
+	}
+
+	static constexpr std::uint32_t no_slot{ std::numeric_limits<std::uint32_t>::max() };
+	static constexpr char prefix_separator{ '.' };
+	static constexpr std::size_t sealed_symbol_threshold{ 16 };
+
+	[[nodiscard]] constexpr std::unique_ptr<_Ty> clone_under(_Ty*) const;
+
+	////////////////////////////////////////////////////////////
+	/// Store a child last in my container and among my siblings, and index it
+	////////////////////////////////////////////////////////////
+	_Ty& adopt(Symbol, std::unique_ptr<_Ty>);
+
+	////////////////////////////////////////////////////////////
+	/// Throw an exception if new_parent is one of these nodes or one of their descendants
+	////////////////////////////////////////////////////////////
+	static void check_not_under(std::span<_Ty* const>, _Ty const& new_parent);
+
+	////////////////////////////////////////////////////////////
+	/// Make sure n more children fit in my container, growing it geometrically as push_back does
+	////////////////////////////////////////////////////////////
+	void make_room(std::size_t n)
+	{
+		if (m_children.capacity() - m_children.size() < n)
+			m_children.reserve(std::max(m_children.size() + n, 2 * m_children.capacity()));
+		if (auto* list = sibling_list())
+			list->links.reserve(m_children.capacity());
+	}
+
+	////////////////////////////////////////////////////////////
+	/// Take the child stored at this position out of my storage :
+	/// the following children shift down, or with Order::unordered my last stored child fills the hole
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] std::unique_ptr<_Ty> erase_slot(std::uint32_t) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// The child stored at this position, nullptr past the end (no_slot included)
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] _Ty* child_at(std::uint32_t slot) const noexcept { return slot < m_children.size() ? m_children[slot].second.get() : nullptr; }
+
+	////////////////////////////////////////////////////////////
+	/// The sibling after and before the child stored at this position, from my sibling list or from my storage
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] _Ty* sibling_after(std::uint32_t slot) const noexcept;
+	[[nodiscard]] _Ty* sibling_before(std::uint32_t slot) const noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// Move one of my children before next among my siblings (last when next is nullptr)
+	////////////////////////////////////////////////////////////
+	void reorder(_Ty& child, _Ty const* next);
+
+	////////////////////////////////////////////////////////////
+	/// Order::insertion : move the children stored at first..last-1 before the position to, the children in between shift
+	////////////////////////////////////////////////////////////
+	void move_slots(std::uint32_t first, std::uint32_t last, std::uint32_t to) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// Sibling list : put the child stored at a slot before the one at next (last when next is no_slot), take it out of the list
+	////////////////////////////////////////////////////////////
+	void link(std::uint32_t slot, std::uint32_t next) noexcept;
+	void unlink(std::uint32_t slot) noexcept;
+
+	void check_child(_Ty const&) const;
+
+	////////////////////////////////////////////////////////////
+	/// Drop a child about to leave my container from the handles and the indices
+	///
+	/// \return true if the child held its path in the index : give its id to index_ties once it left my storage
+	////////////////////////////////////////////////////////////
+	constexpr bool forget(Symbol, _Ty*, PathIndex*) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// Order::unordered : index the positions of my children and link them in the order of my storage
+	////////////////////////////////////////////////////////////
+	void index_positions();
+
+	////////////////////////////////////////////////////////////
+	/// Remove in a single pass the children for which doomed(id, child) is true
+	////////////////////////////////////////////////////////////
+	template<class P>
+	void compact(P&& doomed);
+
+	void prefix_insert(Symbol, _Ty*);
+	void prefix_erase(Symbol, _Ty const*) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// The node of the trie reached by the prefix, nullptr if no id starts with it
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] typename PrefixTrie::Node const* prefix_node(std::string_view) const noexcept;
+
+	template<class F>
+	void prefix_visit(typename PrefixTrie::Node const&, F& f) const;
+
+	[[nodiscard]] static bool has_prefix(std::string_view id, std::string_view prefix) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// The index of my root, nullptr if it has none : only the indexed nodes walk up to their root
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] PathIndex* root_paths() const noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// Index one of my children (under the id s) and all its descendants, a path already taken keeps its node
+	////////////////////////////////////////////////////////////
+	void index_child(PathIndex&, Symbol s, _Ty*) const;
+
+	////////////////////////////////////////////////////////////
+	/// \return true if the node held its path, its descendants are dropped too
+	////////////////////////////////////////////////////////////
+	static bool unindex_subtree(PathIndex&, _Ty*) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// The child get gives may have changed for these ids (a child left, came or moved) : it takes the path from the child holding it
+	////////////////////////////////////////////////////////////
+	void index_ties(PathIndex&, std::span<const Symbol>);
+
+	////////////////////////////////////////////////////////////
+	/// The child get gives, nullptr if I have no child with this id
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] _Ty* find_child(Symbol) const noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// The handle of this child, if any, resolves to nullptr from now on. O(1)
+	////////////////////////////////////////////////////////////
+	constexpr void release(_Ty*) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// Data Members
+	////////////////////////////////////////////////////////////
+	_Ty* m_parent{ nullptr };
+	std::vector<std::pair<Symbol, std::unique_ptr<_Ty >>> m_children{};//ids are compared as symbols, stored once in the IdPool
+	std::unique_ptr<Indices> m_indices{};//created with the first of them, most nodes never have one
+	std::uint32_t m_slot{ 0 };//my position in the m_children of my parent
+	std::uint32_t m_handle : 31 { 0 };//1 + my slot in the handle table of my parent, 0 if I have no handle
+	std::uint32_t m_indexed : 1 { false };//my path is in the index of my root, or I am a root with an index
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Children known at compile time : one slot per enumerator, stored in a dense array
+/// Example : enum class Menu { Play, Options, Quit, count };
+/// struct MainMenu : Container<MainMenu, Menu> { ... };
+/// menu.add(Menu::Play, parameters...);
+/// menu.get(Menu::Play).do_something();
+///
+/// get is a single indexed load, no id is hashed, compared or stored.
+/// The enum class ends with a count enumerator, the number of slots.
+////////////////////////////////////////////////////////////
+template<class _Ty, class _Key> requires std::is_enum_v<_Key>
+class Container<_Ty, _Key>
+{
+	static_assert(requires { _Key::count; }, "The enum class keying a Container needs a last enumerator named count");
+
+public:
+	static constexpr std::size_t slot_count = static_cast<std::size_t>(_Key::count);
+
+	explicit constexpr Container(_Ty* __p = nullptr) noexcept :m_parent(__p) {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Construct a derived object in the slot of this key, what was in the slot is destroyed
+	///
+	/// \return a reference to the freshly created object
+	////////////////////////////////////////////////////////////
+	template<class ...Args>
+	[[nodiscard]] constexpr auto& add(_Key, Args && ...args) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \return a reference to the object in the slot of this key or throw an exception if the slot is empty
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] constexpr auto& get(_Key) const;
+
+	[[nodiscard]] constexpr bool contains(_Key key) const noexcept { return m_slots[index(key)] != nullptr; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Empty the slot of this key
+	////////////////////////////////////////////////////////////
+	constexpr void remove(_Key key) noexcept { m_slots[index(key)].reset(); }
+
+	constexpr void clear() noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Same as Container::apply_foreach, the empty slots are skipped
+	////////////////////////////////////////////////////////////
+	template<auto Func, class ...Args>
+	constexpr void apply_foreach(Args &&... args) noexcept;
+
+	template<class F>
+	constexpr void visit_preorder(F&& f) const;
+
+	[[nodiscard]] constexpr std::unique_ptr<_Ty> clone() const { return clone_under(nullptr); }
+
+protected:
+
+	~Container() = default;
+
+	////////////////////////////////////////////////////////////
+	/// \return Access to the slots, in the order of the enumerators, empty ones are nullptr
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] constexpr auto get_childs() const noexcept -> std::span<std::unique_ptr<_Ty> const> { return m_slots; }
+
+	[[nodiscard]] constexpr _Ty* get_parent()noexcept { return m_parent; }
+
+private:
+	[[nodiscard]] static constexpr std::size_t index(_Key key) noexcept { return static_cast<std::size_t>(key); }
+	[[nodiscard]] constexpr std::unique_ptr<_Ty> clone_under(_Ty*) const;
+
 	////////////////////////////////////////////////////////////
 	/// Data Members
 	////////////////////////////////////////////////////////////
 	_Ty* m_parent{ nullptr };
-	std::vector<std::pair<std::string, std::unique_ptr<_Ty >>> m_children{};
+	std::array<std::unique_ptr<_Ty>, slot_count> m_slots{};
 };
 
 #endif // !Container_h
 
-template<class _Ty>
+template<class _Ty, class _Key>
 template<class ...Args>
-inline constexpr auto& Container<_Ty>::add(std::string_view id, Args && ...args) noexcept
+inline constexpr auto& Container<_Ty, _Key>::add(std::string_view id, Args && ...args) noexcept
 {
-	m_children.emplace_back(std::piecewise_construct, std::forward_as_tuple(id),
-		std::forward_as_tuple(std::make_unique<_Ty>(static_cast<_Ty*>(this), std::forward<Args>(args)...)));
-	return *m_children.back().second;
+	return add(IdPool::shared().intern(id), std::forward<Args>(args)...);
 }
 
-template<class _Ty>
-inline constexpr auto& Container<_Ty>::get(std::string_view id) const
+template<class _Ty, class _Key>
+template<class ...Args>
+inline constexpr auto& Container<_Ty, _Key>::add(HashedId id, Args && ...args) noexcept
 {
-	const auto elem = std::views::keys(m_children);
+	return add(IdPool::shared().intern(id), std::forward<Args>(args)...);
+}
+
+template<class _Ty, class _Key>
+template<class ...Args>
+inline constexpr auto& Container<_Ty, _Key>::add(Symbol id, Args && ...args) noexcept
+{
+	return adopt(id, std::make_unique<_Ty>(static_cast<_Ty*>(this), std::forward<Args>(args)...));
+}
+
+template<class _Ty, class _Key>
+template<std::ranges::input_range R>
+inline constexpr void Container<_Ty, _Key>::add_range(R&& entries)
+{
+	if constexpr (std::ranges::sized_range<R>)
+		make_room(std::ranges::size(entries));
+
+	for (auto&& entry : entries)
+	{
+		using entry_t = std::conditional_t<std::is_lvalue_reference_v<R>, decltype(entry), std::remove_reference_t<decltype(entry)>&&>;
+		std::apply([this](auto&& id, auto&& ...args) {
+			(void)add(std::forward<decltype(id)>(id), std::forward<decltype(args)>(args)...);
+			}, static_cast<entry_t>(entry));
+	}
+}
+
+template<class _Ty, class _Key>
+inline constexpr auto& Container<_Ty, _Key>::get(std::string_view id) const
+{
+	if (auto const* table = sealed_table())
+	{
+		if (auto* child = table->find(fnv1a(id)))
+			return *child;
+		throw std::range_error("didn't find the id of your object");
+	}
+
+	//an id never interned can't be the id of a child, nothing is added to the pool
+	if (const auto symbol = IdPool::shared().find(id))
+		return get(*symbol);
+	throw std::range_error("didn't find the id of your object");
+}
+
+template<class _Ty, class _Key>
+inline constexpr auto& Container<_Ty, _Key>::get(Symbol id) const
+{
+	//comparing a few symbols is faster than hashing
+	if (auto const* table = sealed_table(); table && m_children.size() > sealed_symbol_threshold)
+	{
+		if (auto* child = table->find(IdPool::shared().hash(id)))
+			return *child;
+		throw std::range_error("didn't find the id of your object");
+	}
+
+	if (auto* child = find_child(id))
+		return *child;
+	throw std::range_error("didn't find the id of your object");
+}
+
+template<class _Ty, class _Key>
+inline _Ty* Container<_Ty, _Key>::find_child(Symbol id) const noexcept
+{
+	if (auto const* positions = position_index())
+	{
+		const auto it = positions->find(id.value());
+		return it != positions->end() ? m_children[it->second].second.get() : nullptr;
+	}
 
-	if (const auto it = std::ranges::find(elem, id, [](auto&& d) {return d; }); it != std::ranges::end(elem))
-		return *it.base()->second;
+	const auto elem = std::views::keys(m_children);
+	const auto it = std::ranges::find(elem, id);
+	return it != std::ranges::end(elem) ? it.base()->second.get() : nullptr;
+}
+
+template<class _Ty, class _Key>
+inline constexpr auto& Container<_Ty, _Key>::get(HashedId id) const
+{
+	if (auto const* table = sealed_table())
+	{
+		if (auto* child = table->find(id.hash()))
+			return *child;
+		throw std::range_error("didn't find the id of your object");
+	}
+
+	if (const auto symbol = IdPool::shared().find(id))
+		return get(*symbol);
 	throw std::range_error("didn't find the id of your object");
 }
 
-template<class _Ty>
-inline constexpr void Container<_Ty>::remove(std::string_view id) noexcept
+template<class _Ty, class _Key>
+inline constexpr void Container<_Ty, _Key>::remove(std::string_view id)
+{
+	if (const auto symbol = IdPool::shared().find(id))
+		remove(*symbol);
+}
+
+template<class _Ty, class _Key>
+inline constexpr void Container<_Ty, _Key>::remove(Symbol id)
 {
-	const auto pred = [&](auto const& p) { return p.first == id; };
-	std::erase_if(m_children, pred);
+	auto* paths = root_paths();
+	unseal();
+
+	if (auto* index = position_index())
+	{
+		auto& positions = *index;
+		const auto by_position = [](auto const& a, auto const& b) { return a.second < b.second; };
+
+		//the children with this id from the last one : my last child is never one of them when it fills a hole
+		for (auto range = positions.equal_range(id.value()); range.first != range.second; range = positions.equal_range(id.value()))
+		{
+			const std::uint32_t index = std::max_element(range.first, range.second, by_position)->second;
+			forget(id, m_children[index].second.get(), paths);
+			(void)erase_slot(index);
+		}
+		return;
+	}
+
+	compact([id](Symbol key, _Ty const&) { return key == id; });
 }
 
-template<class _Ty>
-inline constexpr void Container<_Ty>::clear() noexcept
+template<class _Ty, class _Key>
+inline constexpr void Container<_Ty, _Key>::remove(HashedId id)
 {
+	if (const auto symbol = IdPool::shared().find(id))
+		remove(*symbol);
+}
+
+template<class _Ty, class _Key>
+inline constexpr void Container<_Ty, _Key>::clear() noexcept
+{
+	auto* paths = root_paths();
+	const bool handles = handle_table();
+	if (handles || paths)
+		for (auto const& child : std::views::values(m_children))
+		{
+			if (handles)
+				release(child.get());
+			if (paths)
+				unindex_subtree(*paths, child.get());
+		}
+	if (auto* positions = position_index())
+		positions->clear();
+	if (auto* list = sibling_list())
+		*list = {};
+	if (auto* trie = prefix_trie())
+	{
+		trie->nodes.resize(1);
+		trie->nodes.front() = {};
+		trie->free.clear();
+	}
+
+	unseal();
 	if (!m_children.empty())
 		m_children.clear();
 }
 
-template<class _Ty>
+template<class _Ty, class _Key>
+inline constexpr auto Container<_Ty, _Key>::handle_of(_Ty const& child) -> Handle
+{
+	check_child(child);
+
+	auto& table = indices().handles;
+	if (!table)
+		table = std::make_unique<HandleTable>();
+	auto& [slots, free] = *table;
+
+	if (const std::uint32_t index = child.m_handle)
+		return { index - 1, slots[index - 1].generation };
+
+	std::uint32_t index;
+	if (free.empty())
+	{
+		index = static_cast<std::uint32_t>(slots.size());
+		slots.push_back({ nullptr, 0 });
+		free.reserve(slots.size());//release never allocates
+	}
+	else
+	{
+		index = free.back();
+		free.pop_back();
+	}
+
+	auto& slot = slots[index];
+	slot.node = const_cast<_Ty*>(&child);
+	++slot.generation;
+	slot.node->m_handle = index + 1;
+	return { index, slot.generation };
+}
+
+template<class _Ty, class _Key>
+inline constexpr _Ty* Container<_Ty, _Key>::resolve(Handle h) const noexcept
+{
+	auto const* table = handle_table();
+	if (!table || h.index >= table->slots.size())
+		return nullptr;
+
+	auto const& slot = table->slots[h.index];
+	return slot.generation == h.generation ? slot.node : nullptr;
+}
+
+template<class _Ty, class _Key>
+inline constexpr void Container<_Ty, _Key>::release(_Ty* child) noexcept
+{
+	if (!child->m_handle)
+		return;
+
+	const std::uint32_t index = child->m_handle - 1;
+	auto& [slots, free] = *handle_table();
+	slots[index].node = nullptr;
+	free.push_back(index);
+	child->m_handle = 0;
+}
+
+template<class _Ty, class _Key>
 template<auto Func, class ...Args>
-inline constexpr void Container<_Ty>::apply_foreach(Args &&... args) noexcept
+inline constexpr void Container<_Ty, _Key>::apply_foreach(Args &&... args) noexcept
 {
 	std::invoke(Func, static_cast<_Ty*>(this), std::forward<Args>(args)...);
 
-	const auto pred = [&](auto&& d) { std::invoke(Func, d, std::forward<Args>(args)...); };
-	std::ranges::for_each(std::views::values(m_children), pred);
+	for_each_child([&](_Ty& child) { std::invoke(Func, &child, std::forward<Args>(args)...); });
+}
+
+template<class _Ty, class _Key>
+template<class F>
+inline constexpr void Container<_Ty, _Key>::visit_preorder(F&& f) const
+{
+	std::invoke(f, static_cast<_Ty const&>(*this));
+
+	for_each_child([&f](_Ty const& child) { child.visit_preorder(f); });
+}
+
+template<class _Ty, class _Key>
+inline constexpr std::unique_ptr<_Ty> Container<_Ty, _Key>::clone() const
+{
+	return clone_under(nullptr);
+}
+
+template<class _Ty, class _Key>
+inline constexpr std::unique_ptr<_Ty> Container<_Ty, _Key>::clone_under(_Ty* parent) const
+{
+	auto copy = std::make_unique<_Ty>(parent, static_cast<_Ty const&>(*this));
+
+	//the copy keeps the order of my siblings in its storage, it has no sibling list
+	copy->m_children.reserve(m_children.size());
+	for_each_child([&](_Ty const& child) { copy->adopt(m_children[child.m_slot].first, child.clone_under(copy.get())); });
+
+	return copy;
+}
+
+template<class _Ty, class _Key>
+template<class F>
+inline constexpr void Container<_Ty, _Key>::instantiate(std::string_view prefix, _Ty const& prototype, std::size_t n, F&& init)
+{
+	//copying me or one of my ancestors would read my container while it grows : copy it once first
+	std::unique_ptr<_Ty> detached;
+	for (_Ty const* node = static_cast<_Ty const*>(this); node && !detached; node = node->m_parent)
+		if (node == &prototype)
+			detached = prototype.clone_under(nullptr);
+	auto const& source = detached ? *detached : prototype;
+
+	make_room(n);
+	auto& pool = IdPool::shared();
+	std::string id(prefix);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		id.resize(prefix.size());
+		id += std::to_string(i);
+		auto& copy = adopt(pool.intern(id), source.clone_under(static_cast<_Ty*>(this)));
+		std::invoke(init, copy, i);
+	}
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::index_paths(bool enable)
+{
+	if (!enable)
+	{
+		if (auto* paths = path_index())
+		{
+			for (auto const node : std::views::keys(paths->by_node))
+				const_cast<_Ty*>(node)->m_indexed = false;
+			m_indices->paths.reset();
+		}
+		m_indexed = false;
+		return;
+	}
+	if (m_parent)
+		throw std::logic_error("Only a root can index the paths of its descendants");
+	if (path_index())
+		return;
+
+	auto& paths = *(indices().paths = std::make_unique<PathIndex>());
+	m_indexed = true;
+	for (auto const& [id, child] : m_children)
+		index_child(paths, id, child.get());
+}
+
+template<class _Ty, class _Key>
+inline _Ty* Container<_Ty, _Key>::find_path(std::string_view path) const
+{
+	if (auto const* paths = path_index())
+	{
+		const auto it = paths->by_path.find(path);
+		return it != paths->by_path.end() ? it->second : nullptr;
+	}
+
+	auto const& pool = IdPool::shared();
+	Container const* node = this;
+	_Ty* found = nullptr;
+	for (const auto segment : std::views::split(path, '/'))
+	{
+		const auto symbol = pool.find(std::string_view(segment.begin(), segment.end()));
+		if (!symbol)
+			return nullptr;
+
+		found = node->find_child(*symbol);
+		if (!found)
+			return nullptr;
+		node = found;
+	}
+	return found;
+}
+
+template<class _Ty, class _Key>
+inline auto Container<_Ty, _Key>::root_paths() const noexcept -> PathIndex*
+{
+	if (!m_indexed)
+		return nullptr;
+
+	Container const* root = this;
+	while (root->m_parent)
+		root = root->m_parent;
+	return root->path_index();
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::index_child(PathIndex& paths, Symbol s, _Ty* child) const
+{
+	//my path, nothing for the root ; a node being constructed isn't indexed yet, its parent indexes it once it is added
+	std::string path;
+	if (m_parent)
+	{
+		const auto it = paths.by_node.find(static_cast<_Ty const*>(this));
+		if (it == paths.by_node.end())
+			return;
+		path.reserve(it->second.size() + 1 + IdPool::shared().name(s).size());
+		path.append(it->second).push_back('/');
+	}
+	path.append(IdPool::shared().name(s));
+
+	const auto [it, added] = paths.by_path.emplace(std::move(path), child);
+	if (!added)
+		return;
+	paths.by_node.emplace(child, it->first);
+	child->m_indexed = true;
+
+	for (auto const& [id, grandchild] : child->m_children)
+		child->index_child(paths, id, grandchild.get());
+}
+
+template<class _Ty, class _Key>
+inline bool Container<_Ty, _Key>::unindex_subtree(PathIndex& paths, _Ty* node) noexcept
+{
+	//the descendants of a node without a path have none either
+	if (!node->m_indexed)
+		return false;
+
+	const auto it = paths.by_node.find(node);
+	paths.by_path.erase(paths.by_path.find(it->second));
+	paths.by_node.erase(it);
+	node->m_indexed = false;
+
+	for (auto const& child : std::views::values(node->m_children))
+		unindex_subtree(paths, child.get());
+	return true;
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::index_ties(PathIndex& paths, std::span<const Symbol> ids)
+{
+	const auto take_path = [&](Symbol id, _Ty* chosen, _Ty* holder) {
+		if (!chosen || chosen == holder)
+			return;
+		if (holder)
+			unindex_subtree(paths, holder);
+		index_child(paths, id, chosen);
+	};
+
+	if (auto const* positions = position_index())
+	{
+		//only the children with the id are read
+		for (const auto id : ids)
+		{
+			_Ty* holder = nullptr;
+			for (auto [it, end] = positions->equal_range(id.value()); it != end && !holder; ++it)
+				if (_Ty* child = m_children[it->second].second.get(); child->m_indexed)
+					holder = child;
+			take_path(id, find_child(id), holder);
+		}
+		return;
+	}
+
+	//get gives the first child stored with an id : one pass for all the ids
+	std::unordered_map<std::uint32_t, std::pair<_Ty*, _Ty*>> ties;//symbol to the first child and the holder
+	ties.reserve(ids.size());
+	for (const auto id : ids)
+		ties.try_emplace(id.value(), nullptr, nullptr);
+	for (auto const& [id, child] : m_children)
+		if (const auto it = ties.find(id.value()); it != ties.end())
+		{
+			auto& [first, holder] = it->second;
+			if (!first)
+				first = child.get();
+			if (child->m_indexed)
+				holder = child.get();
+		}
+	for (auto const& [id, tie] : ties)
+		take_path(Symbol(id), tie.first, tie.second);
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::index_prefixes(bool enable)
+{
+	if (!enable)
+	{
+		if (m_indices)
+			m_indices->prefixes.reset();
+		return;
+	}
+	if (prefix_trie())
+		return;
+
+	indices().prefixes = std::make_unique<PrefixTrie>();
+	for (auto const& [id, child] : m_children)
+		prefix_insert(id, child.get());
+}
+
+template<class _Ty, class _Key>
+template<class F>
+inline void Container<_Ty, _Key>::for_each_prefix(std::string_view prefix, F&& f) const
+{
+	if (!prefix_trie())
+	{
+		for (auto const& [id, child] : m_children)
+			if (has_prefix(IdPool::shared().name(id), prefix))
+				std::invoke(f, *child);
+		return;
+	}
+
+	if (auto const* node = prefix_node(prefix))
+		prefix_visit(*node, f);
+}
+
+template<class _Ty, class _Key>
+inline std::size_t Container<_Ty, _Key>::count_prefix(std::string_view prefix) const
+{
+	if (!prefix_trie())
+		return std::ranges::count_if(std::views::keys(m_children), [prefix](Symbol id) { return has_prefix(IdPool::shared().name(id), prefix); });
+
+	auto const* node = prefix_node(prefix);
+	return node ? node->count : 0;
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::remove_prefix(std::string_view prefix)
+{
+	//every child with a removed id matches too : no other child takes a path over
+	std::vector<_Ty*> doomed;
+	for_each_prefix(prefix, [&doomed](_Ty& child) { doomed.push_back(&child); });
+	if (doomed.empty())
+		return;
+
+	if (position_index())
+	{
+		//each match knows its slot, my last child fills it
+		unseal();
+		auto* paths = root_paths();
+		for (auto* child : doomed)
+		{
+			forget(m_children[child->m_slot].first, child, paths);
+			(void)erase_slot(child->m_slot);
+		}
+		return;
+	}
+
+	std::vector<bool> marked(m_children.size());
+	for (auto const* child : doomed)
+		marked[child->m_slot] = true;
+	compact([&marked](Symbol, _Ty const& child) { return marked[child.m_slot]; });
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::seal()
+{
+	auto const& pool = IdPool::shared();
+
+	//a repeated id keeps the child get gives : the first one stored, or the one of the index of positions
+	auto const* positions = position_index();
+	std::vector<std::pair<std::uint64_t, _Ty*>> entries;
+	entries.reserve(m_children.size());
+	for (auto const& [id, child] : m_children)
+		if (!positions || find_child(id) == child.get())
+			entries.emplace_back(pool.hash(id), child.get());
+	std::ranges::stable_sort(entries, {}, &std::pair<std::uint64_t, _Ty*>::first);
+	const auto [first, last] = std::ranges::unique(entries, {}, &std::pair<std::uint64_t, _Ty*>::first);
+	entries.erase(first, last);
+
+	indices().sealed = std::make_unique<PerfectHash<_Ty>>(entries);
+
+	for (auto const& child : std::views::values(m_children))
+		child->seal();
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::set_order(Order order)
+{
+	if (order == get_order())
+		return;
+
+	if (order == Order::insertion)
+	{
+		//my storage takes the order of my siblings
+		auto const& list = *sibling_list();
+		std::vector<std::pair<Symbol, std::unique_ptr<_Ty>>> sorted;
+		sorted.reserve(m_children.size());
+		for (auto slot = list.first; slot != no_slot; slot = list.links[slot].next)
+			sorted.push_back(std::move(m_children[slot]));
+		m_children = std::move(sorted);
+		for (std::uint32_t i = 0; i < m_children.size(); ++i)
+			m_children[i].second->m_slot = i;
+		m_indices->positions.reset();
+		m_indices->siblings.reset();
+	}
+	else
+		index_positions();
+
+	//a repeated id may give another child
+	unseal();
+	if (auto* paths = root_paths())
+	{
+		const auto ids = std::views::keys(m_children);
+		index_ties(*paths, std::vector<Symbol>(ids.begin(), ids.end()));
+	}
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::index_positions()
+{
+	const auto size = static_cast<std::uint32_t>(m_children.size());
+	auto positions = std::make_unique<Positions>();
+	auto list = std::make_unique<SiblingList>();
+	positions->reserve(size);
+	list->links.reserve(size);
+	for (std::uint32_t i = 0; i < size; ++i)
+	{
+		positions->emplace(m_children[i].first.value(), i);
+		list->links.push_back({ i ? i - 1 : no_slot, i + 1 < size ? i + 1 : no_slot });
+	}
+	if (size)
+	{
+		list->first = 0;
+		list->last = size - 1;
+	}
+
+	auto& index = indices();
+	index.positions = std::move(positions);
+	index.siblings = std::move(list);
+}
+
+template<class _Ty, class _Key>
+inline constexpr bool Container<_Ty, _Key>::forget(Symbol id, _Ty* child, PathIndex* paths) noexcept
+{
+	if (handle_table())
+		release(child);
+	if (prefix_trie())
+		prefix_erase(id, child);
+	return paths && unindex_subtree(*paths, child);
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::remove(std::span<const std::string_view> ids)
+{
+	auto const& pool = IdPool::shared();
+
+	//ids never interned can't be the id of a child
+	std::vector<std::uint32_t> doomed;
+	doomed.reserve(ids.size());
+	for (const auto id : ids)
+		if (const auto symbol = pool.find(id))
+			doomed.push_back(symbol->value());
+	if (doomed.empty())
+		return;
+	std::ranges::sort(doomed);
+
+	compact([&doomed](Symbol key, _Ty const&) { return std::ranges::binary_search(doomed, key.value()); });
+}
+
+template<class _Ty, class _Key>
+template<class P>
+inline void Container<_Ty, _Key>::remove_if(P&& pred)
+{
+	auto const& pool = IdPool::shared();
+	compact([&](Symbol key, _Ty const& child) -> bool {
+		if constexpr (std::is_invocable_v<P&, std::string_view, _Ty const&>)
+			return std::invoke(pred, pool.name(key), child);
+		else
+			return std::invoke(pred, child);
+		});
+}
+
+template<class _Ty, class _Key>
+template<class P>
+inline void Container<_Ty, _Key>::remove_descendants_if(P&& pred)
+{
+	remove_if(pred);
+
+	for (auto const& child : std::views::values(m_children))
+		child->remove_descendants_if(pred);
+}
+
+template<class _Ty, class _Key>
+template<class P>
+inline void Container<_Ty, _Key>::compact(P&& doomed)
+{
+	constexpr auto gone = std::numeric_limits<std::uint32_t>::max();
+
+	//doomed is called on every child before anything changes : if it throws, my container is left as it was
+	std::vector<std::uint32_t> slots;//the new position of each child, gone for the removed ones
+	std::vector<Symbol> orphaned;//the ids of the removed children which held their path
+	slots.reserve(m_children.size());
+	std::uint32_t kept = 0;
+	for (auto const& [id, child] : m_children)
+	{
+		const bool removed = std::invoke(doomed, id, static_cast<_Ty const&>(*child));
+		slots.push_back(removed ? gone : kept++);
+		if (removed && child->m_indexed)
+			orphaned.push_back(id);
+	}
+	if (kept == m_children.size())
+		return;
+	std::vector<typename SiblingList::Link> links(sibling_list() ? kept : 0);//the sibling list once compacted
+
+	//nothing below throws until my container is consistent again
+	unseal();
+	auto* paths = root_paths();
+	for (std::uint32_t i = 0; i < m_children.size(); ++i)
+	{
+		auto& [id, child] = m_children[i];
+		if (slots[i] == gone)
+		{
+			forget(id, child.get(), paths);
+			child.reset();
+		}
+		else if (slots[i] != i)
+		{
+			child->m_slot = slots[i];
+			m_children[slots[i]] = std::move(m_children[i]);
+		}
+	}
+	m_children.erase(m_children.begin() + kept, m_children.end());
+
+	if (auto* positions = position_index())
+	{
+		for (auto it = positions->begin(); it != positions->end();)
+			if (const auto slot = slots[it->second]; slot == gone)
+				it = positions->erase(it);
+			else
+			{
+				it->second = slot;
+				++it;
+			}
+
+		//the links of the kept children skip the removed ones and point to the new slots
+		auto& list = *sibling_list();
+		const auto kept_slot = [&](std::uint32_t slot, bool forward) {
+			while (slot != no_slot && slots[slot] == gone)
+				slot = forward ? list.links[slot].next : list.links[slot].prev;
+			return slot == no_slot ? no_slot : slots[slot];
+		};
+		for (std::uint32_t i = 0; i < slots.size(); ++i)
+			if (slots[i] != gone)
+				links[slots[i]] = { kept_slot(list.links[i].prev, false), kept_slot(list.links[i].next, true) };
+		list.first = kept_slot(list.first, true);
+		list.last = kept_slot(list.last, false);
+		list.links = std::move(links);
+	}
+
+	if (!orphaned.empty())
+		index_ties(*paths, orphaned);
+}
+
+template<class _Ty, class _Key>
+template<class F>
+inline void Container<_Ty, _Key>::for_each_child(F&& f) const
+{
+	if (auto const* list = sibling_list())
+	{
+		for (auto slot = list->first; slot != no_slot; slot = list->links[slot].next)
+			std::invoke(f, *m_children[slot].second);
+		return;
+	}
+
+	for (auto const& child : std::views::values(m_children))
+		std::invoke(f, *child);
+}
+
+template<class _Ty, class _Key>
+inline _Ty* Container<_Ty, _Key>::first_child() const noexcept
+{
+	auto const* list = sibling_list();
+	return child_at(list ? list->first : 0);
+}
+
+template<class _Ty, class _Key>
+inline _Ty* Container<_Ty, _Key>::last_child() const noexcept
+{
+	auto const* list = sibling_list();
+	return child_at(list ? list->last : m_children.empty() ? no_slot : static_cast<std::uint32_t>(m_children.size() - 1));
+}
+
+template<class _Ty, class _Key>
+inline _Ty* Container<_Ty, _Key>::sibling_after(std::uint32_t slot) const noexcept
+{
+	auto const* list = sibling_list();
+	return child_at(list ? list->links[slot].next : slot + 1);
+}
+
+template<class _Ty, class _Key>
+inline _Ty* Container<_Ty, _Key>::sibling_before(std::uint32_t slot) const noexcept
+{
+	auto const* list = sibling_list();
+	return child_at(list ? list->links[slot].prev : slot ? slot - 1 : no_slot);
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::insert_before(_Ty& child, _Ty const& sibling)
+{
+	check_child(child);
+	check_child(sibling);
+	reorder(child, &sibling);
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::insert_after(_Ty& child, _Ty const& sibling)
+{
+	check_child(child);
+	check_child(sibling);
+	if (&child == &sibling)
+		return;
+
+	reorder(child, sibling.next_sibling());
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::move_to_front(_Ty& child)
+{
+	check_child(child);
+	reorder(child, first_child());
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::move_to_back(_Ty& child)
+{
+	check_child(child);
+	reorder(child, nullptr);
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::reorder(_Ty& child, _Ty const* next)
+{
+	if (&child == next)
+		return;
+
+	if (sibling_list())
+	{
+		unlink(child.m_slot);
+		link(child.m_slot, next ? next->m_slot : no_slot);
+		return;
+	}
+
+	const Symbol id = m_children[child.m_slot].first;
+	move_slots(child.m_slot, child.m_slot + 1, next ? next->m_slot : static_cast<std::uint32_t>(m_children.size()));
+
+	//the first child stored with a repeated id may be another one
+	if (std::ranges::count(std::views::keys(m_children), id) > 1)
+	{
+		unseal();
+		if (auto* paths = root_paths())
+			index_ties(*paths, std::span(&id, 1));
+	}
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::move_slots(std::uint32_t first, std::uint32_t last, std::uint32_t to) noexcept
+{
+	const auto begin = m_children.begin();
+	std::uint32_t low, high;//the children which moved
+	if (to < first)
+	{
+		std::rotate(begin + to, begin + first, begin + last);
+		low = to;
+		high = last;
+	}
+	else if (to > last)
+	{
+		std::rotate(begin + first, begin + last, begin + to);
+		low = first;
+		high = to;
+	}
+	else
+		return;
+
+	for (auto i = low; i < high; ++i)
+		m_children[i].second->m_slot = i;
+}
+
+template<class _Ty, class _Key>
+inline std::unique_ptr<_Ty> Container<_Ty, _Key>::detach(_Ty& child)
+{
+	check_child(child);
+
+	unseal();
+	auto* paths = root_paths();
+	const Symbol id = m_children[child.m_slot].first;
+	const bool held = forget(id, &child, paths);
+	auto node = erase_slot(child.m_slot);
+	node->m_parent = nullptr;
+	if (held)
+		index_ties(*paths, std::span(&id, 1));
+	return node;
+}
+
+template<class _Ty, class _Key>
+inline _Ty& Container<_Ty, _Key>::move_child(std::string_view id, _Ty& new_parent)
+{
+	if (const auto symbol = IdPool::shared().find(id))
+		return move_child(*symbol, new_parent);
+	throw std::range_error("didn't find the id of your object");
+}
+
+template<class _Ty, class _Key>
+inline _Ty& Container<_Ty, _Key>::move_child(HashedId id, _Ty& new_parent)
+{
+	if (const auto symbol = IdPool::shared().find(id))
+		return move_child(*symbol, new_parent);
+	throw std::range_error("didn't find the id of your object");
+}
+
+template<class _Ty, class _Key>
+inline _Ty& Container<_Ty, _Key>::move_child(Symbol id, _Ty& new_parent)
+{
+	return move_child(get(id), new_parent);
+}
+
+template<class _Ty, class _Key>
+inline _Ty& Container<_Ty, _Key>::move_child(_Ty& child, _Ty& new_parent)
+{
+	check_child(child);
+	_Ty* const node = &child;
+	check_not_under(std::span(&node, 1), new_parent);
+	const Symbol id = m_children[child.m_slot].first;
+
+	//the only allocation which would lose the child if it failed after its removal
+	new_parent.make_room(1);
+	unseal();
+	auto* paths = root_paths();
+	const bool held = forget(id, &child, paths);
+	auto& moved = new_parent.adopt(id, erase_slot(child.m_slot));
+	if (held)
+		index_ties(*paths, std::span(&id, 1));
+	return moved;
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::splice(_Ty& first, _Ty& last, _Ty& new_parent, _Ty const* before)
+{
+	check_child(first);
+	check_child(last);
+	if (before && before->m_parent != &new_parent)
+		throw std::invalid_argument("The child to insert before doesn't belong to the new parent");
+
+	std::vector<_Ty*> range;
+	for (_Ty* node = &first; ; node = sibling_after(node->m_slot))
+	{
+		if (!node)
+			throw std::invalid_argument("The last child of the range is before the first one");
+		if (node == before)
+			throw std::invalid_argument("Can't insert a range before one of its children");
+		range.push_back(node);
+		if (node == &last)
+			break;
+	}
+
+	if (&new_parent == static_cast<_Ty*>(this))
+	{
+		if (sibling_list())
+		{
+			for (auto* node : range)
+			{
+				unlink(node->m_slot);
+				link(node->m_slot, before ? before->m_slot : no_slot);
+			}
+			return;
+		}
+
+		//my storage is in the order of my siblings : the range is one block
+		std::vector<Symbol> ids;
+		ids.reserve(range.size());
+		for (auto* node : range)
+			ids.push_back(m_children[node->m_slot].first);
+		move_slots(first.m_slot, last.m_slot + 1, before ? before->m_slot : static_cast<std::uint32_t>(m_children.size()));
+		unseal();
+		if (auto* paths = root_paths())
+			index_ties(*paths, ids);
+		return;
+	}
+
+	check_not_under(range, new_parent);
+	new_parent.make_room(range.size());
+	std::vector<std::pair<Symbol, std::unique_ptr<_Ty>>> taken;
+	std::vector<Symbol> orphaned;//the ids of the children of the range which held their path
+	taken.reserve(range.size());
+	orphaned.reserve(range.size());
+
+	unseal();
+	auto* paths = root_paths();
+	if (sibling_list())
+		for (auto* node : range)
+		{
+			const Symbol id = m_children[node->m_slot].first;
+			if (forget(id, node, paths))
+				orphaned.push_back(id);
+			taken.emplace_back(id, erase_slot(node->m_slot));
+		}
+	else
+	{
+		//the range leaves my storage in one pass rather than shifting it once per child
+		for (auto* node : range)
+		{
+			auto& entry = m_children[node->m_slot];
+			if (forget(entry.first, node, paths))
+				orphaned.push_back(entry.first);
+			taken.push_back(std::move(entry));
+		}
+		std::erase_if(m_children, [](auto const& entry) { return !entry.second; });
+		for (auto i = first.m_slot; i < m_children.size(); ++i)
+			m_children[i].second->m_slot = i;
+	}
+
+	//stored last in the new parent, then moved before the child given at once
+	const auto from = static_cast<std::uint32_t>(new_parent.m_children.size());
+	for (auto& [id, node] : taken)
+		new_parent.adopt(id, std::move(node));
+	if (before && new_parent.sibling_list())
+		for (auto i = from; i < new_parent.m_children.size(); ++i)
+		{
+			new_parent.unlink(i);
+			new_parent.link(i, before->m_slot);
+		}
+	else if (before)
+	{
+		new_parent.move_slots(from, static_cast<std::uint32_t>(new_parent.m_children.size()), before->m_slot);
+		if (auto* new_paths = new_parent.root_paths())
+		{
+			const auto ids = std::views::keys(taken);
+			new_parent.index_ties(*new_paths, std::vector<Symbol>(ids.begin(), ids.end()));
+		}
+	}
+	if (!orphaned.empty())
+		index_ties(*paths, orphaned);
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::check_not_under(std::span<_Ty* const> moved, _Ty const& new_parent)
+{
+	for (_Ty const* node = &new_parent; node; node = node->m_parent)
+		if (std::ranges::find(moved, node) != moved.end())
+			throw std::invalid_argument("Can't move a node under itself or one of its descendants");
+}
+
+template<class _Ty, class _Key>
+inline _Ty& Container<_Ty, _Key>::adopt(Symbol id, std::unique_ptr<_Ty> child)
+{
+	unseal();
+	auto& node = *child;
+	node.m_parent = static_cast<_Ty*>(this);
+	node.m_slot = static_cast<std::uint32_t>(m_children.size());
+	m_children.emplace_back(id, std::move(child));
+
+	auto* positions = position_index();
+	if (positions)
+	{
+		positions->emplace(id.value(), node.m_slot);
+		sibling_list()->links.push_back({ no_slot, no_slot });
+		link(node.m_slot, no_slot);
+	}
+	if (prefix_trie())
+		prefix_insert(id, &node);
+	if (auto* paths = root_paths())
+	{
+		index_child(*paths, id, &node);
+		//the index of positions may give the new child for a repeated id
+		if (positions && !node.m_indexed)
+			index_ties(*paths, std::span(&id, 1));
+	}
+	return node;
+}
+
+template<class _Ty, class _Key>
+inline std::unique_ptr<_Ty> Container<_Ty, _Key>::erase_slot(std::uint32_t index) noexcept
+{
+	auto* positions = position_index();
+
+	//moves the entry of a position in positions, or drops it when from == to
+	const auto move_position = [positions](Symbol id, std::uint32_t from, std::uint32_t to) {
+		auto [first, end] = positions->equal_range(id.value());
+		const auto it = std::find_if(first, end, [from](auto const& p) { return p.second == from; });
+		if (from == to)
+			positions->erase(it);
+		else
+			it->second = to;
+	};
+
+	auto& hole = m_children[index];
+	auto node = std::move(hole.second);
+	if (!positions)
+	{
+		//the storage order is the order of my siblings
+		m_children.erase(m_children.begin() + index);
+		for (auto i = index; i < m_children.size(); ++i)
+			m_children[i].second->m_slot = i;
+		return node;
+	}
+	move_position(hole.first, index, index);
+	unlink(index);
+
+	auto& list = *sibling_list();
+	const auto last = static_cast<std::uint32_t>(m_children.size() - 1);
+	if (index != last)
+	{
+		move_position(m_children.back().first, last, index);
+		hole = std::move(m_children.back());
+		hole.second->m_slot = index;
+
+		//the neighbours of my last child find it in its new slot
+		const auto moved = list.links[index] = list.links[last];
+		(moved.prev != no_slot ? list.links[moved.prev].next : list.first) = index;
+		(moved.next != no_slot ? list.links[moved.next].prev : list.last) = index;
+	}
+	m_children.pop_back();
+	list.links.pop_back();
+	return node;
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::link(std::uint32_t slot, std::uint32_t next) noexcept
+{
+	auto& list = *sibling_list();
+	auto& entry = list.links[slot];
+	entry.next = next;
+	entry.prev = next != no_slot ? list.links[next].prev : list.last;
+	(entry.prev != no_slot ? list.links[entry.prev].next : list.first) = slot;
+	(next != no_slot ? list.links[next].prev : list.last) = slot;
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::unlink(std::uint32_t slot) noexcept
+{
+	auto& list = *sibling_list();
+	auto& entry = list.links[slot];
+	(entry.prev != no_slot ? list.links[entry.prev].next : list.first) = entry.next;
+	(entry.next != no_slot ? list.links[entry.next].prev : list.last) = entry.prev;
+	entry = { no_slot, no_slot };
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::check_child(_Ty const& child) const
+{
+	if (child.m_parent != static_cast<_Ty const*>(this))
+		throw std::invalid_argument("This object is not one of my children");
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::prefix_insert(Symbol id, _Ty* child)
+{
+	auto& pool = IdPool::shared();
+	auto& [nodes, free] = *prefix_trie();
+
+	std::uint32_t current = 0;
+	++nodes[current].count;
+	for (const auto segment : std::views::split(pool.name(id), prefix_separator))
+	{
+		const Symbol s = pool.intern(std::string_view(segment.begin(), segment.end()));
+		auto& next = nodes[current].next;
+
+		if (const auto it = next.find(s.value()); it != next.end())
+			current = it->second;
+		else
+		{
+			std::uint32_t added;
+			if (free.empty())
+			{
+				added = static_cast<std::uint32_t>(nodes.size());
+				nodes.emplace_back();
+				free.reserve(nodes.size());//prefix_erase never allocates
+			}
+			else
+			{
+				added = free.back();
+				free.pop_back();
+			}
+			next.emplace(s.value(), added);
+			current = added;
+		}
+		++nodes[current].count;
+	}
+	nodes[current].ends.push_back(child);
+}
+
+template<class _Ty, class _Key>
+inline void Container<_Ty, _Key>::prefix_erase(Symbol id, _Ty const* child) noexcept
+{
+	constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+	auto const& pool = IdPool::shared();
+	auto& [nodes, free] = *prefix_trie();
+
+	//every segment was interned by prefix_insert
+	std::uint32_t current = 0;
+	std::uint32_t pruned = none;//the highest node only this id went through
+	--nodes[current].count;
+	for (const auto segment : std::views::split(pool.name(id), prefix_separator))
+	{
+		auto& next = nodes[current].next;
+		const auto it = next.find(pool.find(std::string_view(segment.begin(), segment.end()))->value());
+		current = it->second;
+		if (--nodes[current].count == 0 && pruned == none)
+		{
+			pruned = current;
+			next.erase(it);
+		}
+	}
+	std::erase(nodes[current].ends, child);
+
+	//below the pruned node there is only the rest of the path of this id
+	while (pruned != none)
+	{
+		auto& node = nodes[pruned];
+		free.push_back(pruned);
+		pruned = node.next.empty() ? none : node.next.begin()->second;
+		node.next.clear();
+	}
+}
+
+template<class _Ty, class _Key>
+inline auto Container<_Ty, _Key>::prefix_node(std::string_view prefix) const noexcept -> typename PrefixTrie::Node const*
+{
+	auto const& pool = IdPool::shared();
+	auto const& nodes = prefix_trie()->nodes;
+
+	std::uint32_t current = 0;
+	if (!prefix.empty())
+		for (const auto segment : std::views::split(prefix, prefix_separator))
+		{
+			const auto s = pool.find(std::string_view(segment.begin(), segment.end()));
+			if (!s)
+				return nullptr;
+
+			auto const& next = nodes[current].next;
+			const auto it = next.find(s->value());
+			if (it == next.end())
+				return nullptr;
+			current = it->second;
+		}
+	return nodes[current].count ? &nodes[current] : nullptr;
+}
+
+template<class _Ty, class _Key>
+template<class F>
+inline void Container<_Ty, _Key>::prefix_visit(typename PrefixTrie::Node const& node, F& f) const
+{
+	for (auto* child : node.ends)
+		std::invoke(f, *child);
+
+	//the emptied branches are pruned : the cost follows the matches
+	for (const auto index : std::views::values(node.next))
+		prefix_visit(prefix_trie()->nodes[index], f);
+}
+
+template<class _Ty, class _Key>
+inline bool Container<_Ty, _Key>::has_prefix(std::string_view id, std::string_view prefix) noexcept
+{
+	return prefix.empty() || (id.starts_with(prefix) && (id.size() == prefix.size() || id[prefix.size()] == prefix_separator));
+}
+
+template<class _Ty, class _Key> requires std::is_enum_v<_Key>
+template<class ...Args>
+inline constexpr auto& Container<_Ty, _Key>::add(_Key key, Args && ...args) noexcept
+{
+	auto& slot = m_slots[index(key)];
+	slot = std::make_unique<_Ty>(static_cast<_Ty*>(this), std::forward<Args>(args)...);
+	return *slot;
+}
+
+template<class _Ty, class _Key> requires std::is_enum_v<_Key>
+inline constexpr auto& Container<_Ty, _Key>::get(_Key key) const
+{
+	if (auto const& slot = m_slots[index(key)])
+		return *slot;
+	throw std::range_error("nothing is stored in the slot of your key");
+}
+
+template<class _Ty, class _Key> requires std::is_enum_v<_Key>
+inline constexpr void Container<_Ty, _Key>::clear() noexcept
+{
+	for (auto& slot : m_slots)
+		slot.reset();
+}
+
+template<class _Ty, class _Key> requires std::is_enum_v<_Key>
+template<auto Func, class ...Args>
+inline constexpr void Container<_Ty, _Key>::apply_foreach(Args &&... args) noexcept
+{
+	std::invoke(Func, static_cast<_Ty*>(this), std::forward<Args>(args)...);
+
+	for (auto const& slot : m_slots)
+		if (slot)
+			std::invoke(Func, slot, std::forward<Args>(args)...);
+}
+
+template<class _Ty, class _Key> requires std::is_enum_v<_Key>
+template<class F>
+inline constexpr void Container<_Ty, _Key>::visit_preorder(F&& f) const
+{
+	std::invoke(f, static_cast<_Ty const&>(*this));
+
+	for (auto const& slot : m_slots)
+		if (slot)
+			slot->visit_preorder(f);
+}
+
+template<class _Ty, class _Key> requires std::is_enum_v<_Key>
+inline constexpr std::unique_ptr<_Ty> Container<_Ty, _Key>::clone_under(_Ty* parent) const
+{
+	auto copy = std::make_unique<_Ty>(parent, static_cast<_Ty const&>(*this));
+
+	for (std::size_t i = 0; i < slot_count; ++i)
+		if (m_slots[i])
+			copy->m_slots[i] = m_slots[i]->clone_under(copy.get());
+
+	return copy;
 }
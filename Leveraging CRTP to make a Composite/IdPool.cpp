@@ -0,0 +1,90 @@
+#include "IdPool.h"
+#include <algorithm>
+#include <cstring>
+
+IdPool& IdPool::shared()
+{
+	static IdPool pool;
+	return pool;
+}
+
+Symbol IdPool::intern(std::string_view id)
+{
+	if (const auto it = m_index.find(id); it != m_index.end())
+		return it->second;
+
+	const Symbol symbol(static_cast<std::uint32_t>(m_names.size()));
+	const auto stored = store(id);
+	const auto hash = fnv1a(id);
+	m_names.push_back(stored);
+	m_hashes.push_back(hash);
+	m_index.emplace(stored, symbol);
+	if (const auto [it, added] = m_hashed.emplace(hash, symbol); !added)
+		check_collision(it->second, id);
+	return symbol;
+}
+
+Symbol IdPool::intern(HashedId id)
+{
+	if (const auto it = m_hashed.find(id.hash()); it != m_hashed.end())
+	{
+		check_collision(it->second, id.text());
+		return it->second;
+	}
+	return intern(id.text());
+}
+
+std::optional<Symbol> IdPool::find(std::string_view id) const
+{
+	if (const auto it = m_index.find(id); it != m_index.end())
+		return it->second;
+	return std::nullopt;
+}
+
+std::optional<Symbol> IdPool::find(HashedId id) const
+{
+	if (const auto it = m_hashed.find(id.hash()); it != m_hashed.end())
+	{
+		check_collision(it->second, id.text());
+		return it->second;
+	}
+	return std::nullopt;
+}
+
+std::string_view IdPool::store(std::string_view id)
+{
+	if (id.empty())
+		return {};
+
+	//ids longer than a chunk get a chunk of their own
+	if (m_chunks.empty() || m_chunks.back().size - m_chunks.back().used < id.size())
+	{
+		const std::size_t size = std::max(chunk_size, id.size());
+		m_chunks.push_back({ std::make_unique_for_overwrite<char[]>(size), size, 0 });
+	}
+
+	auto& chunk = m_chunks.back();
+	char* dst = chunk.bytes.get() + chunk.used;
+	std::memcpy(dst, id.data(), id.size());
+	chunk.used += id.size();
+	return { dst, id.size() };
+}
+
+IdPool::MemoryReport IdPool::memory() const noexcept
+{
+	MemoryReport report;
+	report.ids = m_names.size();
+	for (auto const& chunk : m_chunks)
+	{
+		report.arena_used += chunk.used;
+		report.arena_reserved += chunk.size;
+	}
+
+	//one node per id (key, symbol and the next pointer) plus the buckets, as in the usual implementations
+	constexpr std::size_t node_bytes = sizeof(std::string_view) + sizeof(Symbol) + 2 * sizeof(void*);
+	constexpr std::size_t hashed_node_bytes = sizeof(std::uint64_t) + sizeof(Symbol) + 2 * sizeof(void*);
+	report.index_bytes = m_index.size() * node_bytes + m_index.bucket_count() * sizeof(void*)
+		+ m_hashed.size() * hashed_node_bytes + m_hashed.bucket_count() * sizeof(void*)
+		+ m_names.capacity() * sizeof(std::string_view) + m_hashes.capacity() * sizeof(std::uint64_t) + m_chunks.capacity() * sizeof(Chunk);
+	return report;
+}
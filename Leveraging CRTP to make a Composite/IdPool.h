@@ -0,0 +1,155 @@
+#ifndef IDPOOL_H
+#define IDPOOL_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// \brief The small integer standing for an id interned in the IdPool, compared instead of the id itself
+////////////////////////////////////////////////////////////
+class Symbol
+{
+public:
+	constexpr Symbol() noexcept = default;
+	constexpr explicit Symbol(std::uint32_t value) noexcept : m_value{ value } {}
+
+	[[nodiscard]] constexpr std::uint32_t value()const noexcept { return m_value; }
+
+	friend constexpr bool operator==(Symbol, Symbol) noexcept = default;
+
+private:
+	std::uint32_t m_value{ 0 };
+};
+
+////////////////////////////////////////////////////////////
+/// \return The 64 bits FNV-1a hash of an id, the same at compile time and at runtime
+////////////////////////////////////////////////////////////
+[[nodiscard]] constexpr std::uint64_t fnv1a(std::string_view id) noexcept
+{
+	std::uint64_t hash = 14695981039346656037ull;
+	for (const char c : id)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief An id literal hashed by the compiler, looked up in the IdPool without reading its characters
+/// Example : parent.get("child2Name"_id).set_position(pos);
+///
+/// The characters are kept for the first add of the id and for the collision check of debug builds.
+////////////////////////////////////////////////////////////
+class HashedId
+{
+public:
+	consteval HashedId(char const* text, std::size_t size) : m_text{ text, size }, m_hash{ fnv1a(m_text) } {}
+
+	[[nodiscard]] constexpr std::string_view text()const noexcept { return m_text; }
+	[[nodiscard]] constexpr std::uint64_t hash()const noexcept { return m_hash; }
+
+private:
+	std::string_view m_text;
+	std::uint64_t m_hash;
+};
+
+[[nodiscard]] consteval HashedId operator""_id(char const* text, std::size_t size) { return { text, size }; }
+
+////////////////////////////////////////////////////////////
+/// \brief Every id given to a Container, stored once in contiguous chunks and numbered in order of arrival
+/// Example : Symbol s = IdPool::shared().intern("child1Name");
+/// std::string_view id = IdPool::shared().name(s);
+///
+/// Ids are never removed : the pool only grows with the number of distinct ids ever used,
+/// not with the number of children carrying them. Not thread safe, like the rest of the tree.
+////////////////////////////////////////////////////////////
+class IdPool
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief What the pool holds and the memory it takes
+	////////////////////////////////////////////////////////////
+	struct MemoryReport
+	{
+		std::size_t ids{ 0 };
+		std::size_t arena_used{ 0 };//bytes of the ids themselves
+		std::size_t arena_reserved{ 0 };//bytes of all the chunks
+		std::size_t index_bytes{ 0 };//estimate of the hash table and of the symbol table
+	};
+
+	IdPool() = default;
+	IdPool(IdPool const&) = delete;
+	IdPool& operator=(IdPool const&) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \return The pool shared by every Container
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] static IdPool& shared();
+
+	////////////////////////////////////////////////////////////
+	/// \return The symbol of this id, added to the pool the first time it is seen
+	////////////////////////////////////////////////////////////
+	Symbol intern(std::string_view);
+	Symbol intern(HashedId);
+
+	////////////////////////////////////////////////////////////
+	/// \return The symbol of this id, nothing if it was never interned (no child can have it then)
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] std::optional<Symbol> find(std::string_view)const;
+	[[nodiscard]] std::optional<Symbol> find(HashedId)const;
+
+	////////////////////////////////////////////////////////////
+	/// \return The id of a symbol given by this pool, valid as long as the pool
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] std::string_view name(Symbol s)const { return m_names[s.value()]; }
+
+	////////////////////////////////////////////////////////////
+	/// \return fnv1a of the id of a symbol, computed once when it was interned
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] std::uint64_t hash(Symbol s)const { return m_hashes[s.value()]; }
+
+	[[nodiscard]] std::size_t size()const noexcept { return m_names.size(); }
+	[[nodiscard]] MemoryReport memory()const noexcept;
+
+private:
+	static constexpr std::size_t chunk_size{ 4096 };
+
+	struct Chunk
+	{
+		std::unique_ptr<char[]> bytes;
+		std::size_t size;
+		std::size_t used;
+	};
+
+	struct Unmixed
+	{
+		//fnv1a is already well mixed, std::hash would hash it again
+		std::size_t operator()(std::uint64_t hash)const noexcept { return static_cast<std::size_t>(hash); }
+	};
+
+	[[nodiscard]] std::string_view store(std::string_view);
+
+	////////////////////////////////////////////////////////////
+	/// Debug builds stop on two ids with the same hash, release builds keep the first one
+	////////////////////////////////////////////////////////////
+	void check_collision([[maybe_unused]] Symbol found, [[maybe_unused]] std::string_view id)const
+	{
+		assert(name(found) == id && "two ids have the same fnv1a hash, rename one of them");
+	}
+
+	std::vector<Chunk> m_chunks;
+	std::vector<std::string_view> m_names;//indexed by symbol, views into the chunks
+	std::vector<std::uint64_t> m_hashes;//indexed by symbol
+	std::unordered_map<std::string_view, Symbol> m_index;//keys are the views of m_names
+	std::unordered_map<std::uint64_t, Symbol, Unmixed> m_hashed;//fnv1a of every id, what HashedId looks up
+};
+
+#endif
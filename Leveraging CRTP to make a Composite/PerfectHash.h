@@ -0,0 +1,170 @@
+#ifndef PERFECTHASH_H
+#define PERFECTHASH_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// \brief A read-only table from distinct 64 bits hashes to values, built once by hash and displace :
+/// every key has a slot of its own among exactly as many slots as keys
+/// Example : PerfectHash<Button> table(entries);//entries : span of (hash, Button*)
+/// Button* b = table.find(fnv1a("child1Name"));
+///
+/// A lookup reads one pilot then one slot, slots are packed by 4 in 64 bytes aligned lines.
+/// A hash that isn't a key lands on the slot of some key and is rejected by comparing the stored hash.
+////////////////////////////////////////////////////////////
+template<class _Ty>
+class PerfectHash
+{
+public:
+	PerfectHash() = default;
+	explicit PerfectHash(std::span<std::pair<std::uint64_t, _Ty*> const> entries) { build(entries); }
+
+	////////////////////////////////////////////////////////////
+	/// \return The value of this hash or nullptr, O(1) without collision
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] _Ty* find(std::uint64_t hash)const noexcept;
+
+	[[nodiscard]] std::uint32_t size()const noexcept { return m_size; }
+
+	////////////////////////////////////////////////////////////
+	/// \return The bytes of the pilots and of the slots
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] std::size_t memory()const noexcept { return m_pilots.size() * sizeof(std::uint32_t) + m_lines.size() * sizeof(Line); }
+
+private:
+	struct Slot
+	{
+		std::uint64_t hash;
+		_Ty* node;
+	};
+
+	struct alignas(64) Line
+	{
+		std::array<Slot, 4> slots;
+	};
+
+	static constexpr std::uint64_t pilot_step{ 0x9E3779B97F4A7C15ull };
+	static constexpr std::uint32_t max_pilot{ 1u << 20 };
+
+	[[nodiscard]] static std::uint64_t mix(std::uint64_t x) noexcept
+	{
+		//finalizer of splitmix64
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+		return x ^ (x >> 31);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// x in [0, n) from the high bits, without a division
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] static std::uint32_t reduce(std::uint64_t x, std::uint32_t n) noexcept { return static_cast<std::uint32_t>(((x >> 32) * n) >> 32); }
+
+	[[nodiscard]] std::uint32_t bucket(std::uint64_t hash)const noexcept { return reduce(mix(hash ^ m_seed), static_cast<std::uint32_t>(m_pilots.size())); }
+	[[nodiscard]] std::uint32_t slot(std::uint64_t hash, std::uint32_t pilot)const noexcept { return reduce(mix(hash ^ m_seed ^ (pilot * pilot_step)), m_size); }
+
+	void build(std::span<std::pair<std::uint64_t, _Ty*> const>);
+	[[nodiscard]] bool try_build(std::span<std::pair<std::uint64_t, _Ty*> const>);
+
+	std::vector<std::uint32_t> m_pilots;//one per bucket of about 2 keys
+	std::vector<Line> m_lines;
+	std::uint32_t m_size{ 0 };
+	std::uint64_t m_seed{ 0 };
+};
+
+template<class _Ty>
+inline _Ty* PerfectHash<_Ty>::find(std::uint64_t hash)const noexcept
+{
+	if (m_size == 0)
+		return nullptr;
+
+	const std::uint32_t i = slot(hash, m_pilots[bucket(hash)]);
+	auto const& s = m_lines[i >> 2].slots[i & 3];
+	return s.hash == hash ? s.node : nullptr;
+}
+
+template<class _Ty>
+inline void PerfectHash<_Ty>::build(std::span<std::pair<std::uint64_t, _Ty*> const> entries)
+{
+	m_size = static_cast<std::uint32_t>(entries.size());
+	if (m_size == 0)
+		return;
+
+	//a bucket without any pilot fitting is very unlikely, another seed moves every key
+	for (m_seed = 0; !try_build(entries); ++m_seed) {}
+}
+
+template<class _Ty>
+inline bool PerfectHash<_Ty>::try_build(std::span<std::pair<std::uint64_t, _Ty*> const> entries)
+{
+	m_pilots.assign(m_size / 2 + 1, 0);
+	m_lines.assign((m_size + 3) / 4, Line{});
+
+	//keys grouped by bucket, the biggest buckets placed first while most slots are free
+	std::vector<std::uint32_t> buckets(entries.size());
+	for (std::size_t i = 0; i < entries.size(); ++i)
+		buckets[i] = bucket(entries[i].first);
+
+	std::vector<std::uint32_t> sizes(m_pilots.size(), 0);
+	for (const auto b : buckets)
+		++sizes[b];
+
+	std::vector<std::uint32_t> starts(m_pilots.size() + 1, 0);
+	std::partial_sum(sizes.begin(), sizes.end(), starts.begin() + 1);
+	std::vector<std::uint32_t> keys(entries.size());
+	{
+		auto next = starts;
+		for (std::uint32_t i = 0; i < entries.size(); ++i)
+			keys[next[buckets[i]]++] = i;
+	}
+
+	std::vector<std::uint32_t> order(m_pilots.size());
+	std::iota(order.begin(), order.end(), 0u);
+	std::ranges::stable_sort(order, std::greater{}, [&sizes](std::uint32_t b) { return sizes[b]; });
+
+	std::vector<bool> taken(m_size, false);
+	std::vector<std::uint32_t> placed;
+	for (const auto b : order)
+	{
+		if (sizes[b] == 0)
+			break;
+		const auto members = std::span(keys).subspan(starts[b], sizes[b]);
+
+		std::uint32_t pilot = 0;
+		for (;; ++pilot)
+		{
+			if (pilot == max_pilot)
+				return false;
+
+			placed.clear();
+			bool fits = true;
+			for (const auto k : members)
+			{
+				const auto s = slot(entries[k].first, pilot);
+				if (taken[s] || std::ranges::find(placed, s) != placed.end())
+				{
+					fits = false;
+					break;
+				}
+				placed.push_back(s);
+			}
+			if (fits)
+				break;
+		}
+
+		m_pilots[b] = pilot;
+		for (std::size_t j = 0; j < members.size(); ++j)
+		{
+			taken[placed[j]] = true;
+			m_lines[placed[j] >> 2].slots[placed[j] & 3] = { entries[members[j]].first, entries[members[j]].second };
+		}
+	}
+	return true;
+}
+
+#endif
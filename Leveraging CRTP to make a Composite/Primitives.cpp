@@ -0,0 +1,139 @@
+#include "Primitives.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+	constexpr float pi = 3.141592654f;
+}
+
+std::uint32_t circle_point_count(float radius) noexcept
+{
+	//a chord of angle a is at r * (1 - cos(a / 2)) of the arc, keep it under the tolerance
+	constexpr float tolerance = 0.25f;
+	constexpr std::uint32_t min_points = 8, max_points = 256;
+
+	if (!(radius > tolerance))
+		return min_points;
+
+	const float points = std::ceil(pi / std::acos(1.f - tolerance / radius));
+	return std::clamp(static_cast<std::uint32_t>(std::min(points, static_cast<float>(max_points))), min_points, max_points);
+}
+
+sf::Vector2f RectPrimitive::getPoint(std::uint32_t index)const noexcept
+{
+	switch (index)
+	{
+	default:
+	case 0: return { 0.f, 0.f };
+	case 1: return { m_size.x, 0.f };
+	case 2: return { m_size.x, m_size.y };
+	case 3: return { 0.f, m_size.y };
+	}
+}
+
+RoundedRectPrimitive::RoundedRectPrimitive(sf::Vector2f const& size, float corner_radius) noexcept :
+	m_size{ size }, m_corner_radius{ corner_radius }
+{
+	update_corners();
+}
+
+void RoundedRectPrimitive::setSize(sf::Vector2f const& size) noexcept
+{
+	m_size = size;
+	update_corners();
+}
+
+void RoundedRectPrimitive::setCornerRadius(float radius) noexcept
+{
+	m_corner_radius = radius;
+	update_corners();
+}
+
+void RoundedRectPrimitive::update_corners() noexcept
+{
+	m_corner_radius = std::clamp(m_corner_radius, 0.f, std::min(m_size.x, m_size.y) / 2.f);
+	//a quarter of the points of the whole circle, both ends of the arc included
+	m_corner_points = m_corner_radius > 0.f ? circle_point_count(m_corner_radius) / 4 + 1 : 1;
+}
+
+sf::Vector2f RoundedRectPrimitive::getPoint(std::uint32_t index)const noexcept
+{
+	const std::uint32_t corner = index / m_corner_points % 4;
+	const std::uint32_t step = index % m_corner_points;
+	const float r = m_corner_radius;
+
+	//clockwise from the top left corner, each arc turning by a quarter of a turn
+	const sf::Vector2f centers[4] = { { r, r }, { m_size.x - r, r }, { m_size.x - r, m_size.y - r }, { r, m_size.y - r } };
+	const float angle = pi * (1.f + static_cast<float>(corner) / 2.f)
+		+ (m_corner_points > 1 ? pi / 2.f * static_cast<float>(step) / static_cast<float>(m_corner_points - 1) : 0.f);
+
+	return { centers[corner].x + std::cos(angle) * r, centers[corner].y + std::sin(angle) * r };
+}
+
+void CirclePrimitive::setRadius(float radius) noexcept
+{
+	m_radius = radius;
+	m_point_count = circle_point_count(radius);
+}
+
+sf::Vector2f CirclePrimitive::getPoint(std::uint32_t index)const noexcept
+{
+	//same expression as sf::CircleShape::getPoint
+	const float angle = static_cast<float>(std::size_t{ index } * 2) * pi / static_cast<float>(m_point_count) - pi / 2;
+	const float x = std::cos(angle) * m_radius;
+	const float y = std::sin(angle) * m_radius;
+
+	return { m_radius + x, m_radius + y };
+}
+
+sf::FloatRect CirclePrimitive::getLocalBounds()const
+{
+	//r + c * r grows with c when r is positive and shrinks otherwise : the extremes come from the extremes of the unit circle
+	const auto& unit = unit_circle(m_point_count);
+	const float left = std::min(m_radius + unit.min.x * m_radius, m_radius + unit.max.x * m_radius);
+	const float right = std::max(m_radius + unit.min.x * m_radius, m_radius + unit.max.x * m_radius);
+	const float top = std::min(m_radius + unit.min.y * m_radius, m_radius + unit.max.y * m_radius);
+	const float bottom = std::max(m_radius + unit.min.y * m_radius, m_radius + unit.max.y * m_radius);
+
+	return { left, top, right - left, bottom - top };
+}
+
+auto CirclePrimitive::unit_circle(std::uint32_t count) -> UnitCircle const&
+{
+	thread_local std::unordered_map<std::uint32_t, UnitCircle> cache;
+
+	auto [it, inserted] = cache.try_emplace(count);
+	if (inserted)
+	{
+		auto& u = it->second;
+		u.points.resize(count);
+
+		//same expression as sf::CircleShape::getPoint
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			const float angle = static_cast<float>(std::size_t{ i } * 2) * pi / static_cast<float>(count) - pi / 2;
+			u.points[i] = { std::cos(angle), std::sin(angle) };
+		}
+
+		if (count > 0)
+		{
+			const auto [min_x, max_x] = std::ranges::minmax(u.points, {}, &sf::Vector2f::x);
+			const auto [min_y, max_y] = std::ranges::minmax(u.points, {}, &sf::Vector2f::y);
+			u.min = { min_x.x, min_y.y };
+			u.max = { max_x.x, max_y.y };
+		}
+	}
+	return it->second;
+}
+
+void CirclePrimitive::local_points(std::span<sf::Vertex> out)const
+{
+	const auto& unit = unit_circle(m_point_count);
+	for (std::size_t i = 0; i < out.size(); ++i)
+	{
+		const float x = unit.points[i].x * m_radius;
+		const float y = unit.points[i].y * m_radius;
+		out[i].position = { m_radius + x, m_radius + y };
+	}
+}
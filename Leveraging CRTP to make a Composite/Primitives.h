@@ -0,0 +1,286 @@
+#ifndef PRIMITIVES_H
+#define PRIMITIVES_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "SFML/Graphics/Color.hpp"
+#include "SFML/Graphics/Rect.hpp"
+#include "SFML/Graphics/RenderStates.hpp"
+#include "SFML/Graphics/RenderTarget.hpp"
+#include "SFML/Graphics/Texture.hpp"
+#include "SFML/Graphics/Transform.hpp"
+#include "SFML/Graphics/Vertex.hpp"
+
+////////////////////////////////////////////////////////////
+/// \brief Base of the lightweight shapes : a plain value (no vertex array, no vtable, trivially copyable)
+/// with the part of the sf::Shape interface a button uses
+///
+/// The setters only store the value, the geometry is generated when the shape is drawn or batched.
+/// _Ty provides getPointCount() and getPoint(index) like an sf::Shape, the points going around the outline.
+////////////////////////////////////////////////////////////
+template<class _Ty>
+class Primitive
+{
+public:
+	void setPosition(sf::Vector2f const& position) noexcept { m_position = position; }
+	void setPosition(float x, float y) noexcept { m_position = { x, y }; }
+	void setOrigin(sf::Vector2f const& origin) noexcept { m_origin = origin; }
+	void setOrigin(float x, float y) noexcept { m_origin = { x, y }; }
+	void setRotation(float angle) noexcept;
+	void setFillColor(sf::Color const& color) noexcept { m_color = color; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief The whole texture is mapped on the local bounds, nullptr removes it
+	////////////////////////////////////////////////////////////
+	void setTexture(sf::Texture const* texture) noexcept { m_texture = texture; }
+
+	[[nodiscard]] sf::Vector2f const& getPosition()const noexcept { return m_position; }
+	[[nodiscard]] sf::Vector2f const& getOrigin()const noexcept { return m_origin; }
+	[[nodiscard]] float getRotation()const noexcept { return m_rotation; }
+	[[nodiscard]] sf::Color const& getFillColor()const noexcept { return m_color; }
+	[[nodiscard]] sf::Texture const* getTexture()const noexcept { return m_texture; }
+
+	////////////////////////////////////////////////////////////
+	/// \return The same matrix as sf::Transformable::getTransform with a scale of 1
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] sf::Transform getTransform()const noexcept;
+	[[nodiscard]] sf::FloatRect getLocalBounds()const;
+	[[nodiscard]] sf::FloatRect getGlobalBounds()const { return getTransform().transformRect(self().getLocalBounds()); }
+
+	////////////////////////////////////////////////////////////
+	/// \return The number of vertices written by write_triangles
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] std::uint32_t triangle_vertex_count()const { return 3 * self().getPointCount(); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write the shape in world space as sf::Triangles, a fan around the center of the local bounds
+	///
+	/// \param out must hold triangle_vertex_count() vertices
+	////////////////////////////////////////////////////////////
+	void write_triangles(std::span<sf::Vertex> out)const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw right now with a single sf::TriangleFan, what Button::draw does for these shapes
+	////////////////////////////////////////////////////////////
+	void draw(sf::RenderTarget&, sf::RenderStates states = sf::RenderStates::Default)const;
+
+protected:
+	Primitive() = default;
+
+private:
+	[[nodiscard]] _Ty const& self()const noexcept { return static_cast<_Ty const&>(*this); }
+
+	////////////////////////////////////////////////////////////
+	/// Center then every point and the first one again, in local space : an sf::TriangleFan
+	////////////////////////////////////////////////////////////
+	void local_fan(std::vector<sf::Vertex>&)const;
+
+	////////////////////////////////////////////////////////////
+	/// Every getPoint in out, _Ty hides it when it has a faster way
+	////////////////////////////////////////////////////////////
+	void local_points(std::span<sf::Vertex> out)const;
+
+	sf::Vector2f m_position{};
+	sf::Vector2f m_origin{};
+	float m_rotation{ 0.f };
+	sf::Color m_color{ sf::Color::White };
+	sf::Texture const* m_texture{ nullptr };
+};
+
+////////////////////////////////////////////////////////////
+/// \return The number of points keeping a circle of this radius within a quarter of a pixel of the real one,
+/// between 8 and 256 (sf::CircleShape always uses 30)
+////////////////////////////////////////////////////////////
+[[nodiscard]] std::uint32_t circle_point_count(float radius) noexcept;
+
+class RectPrimitive : public Primitive<RectPrimitive>
+{
+public:
+	RectPrimitive() = default;
+	explicit RectPrimitive(sf::Vector2f const& size) noexcept : m_size{ size } {}
+
+	void setSize(sf::Vector2f const& size) noexcept { m_size = size; }
+	[[nodiscard]] sf::Vector2f const& getSize()const noexcept { return m_size; }
+
+	[[nodiscard]] std::uint32_t getPointCount()const noexcept { return 4; }
+	[[nodiscard]] sf::Vector2f getPoint(std::uint32_t)const noexcept;
+
+private:
+	sf::Vector2f m_size{};
+};
+
+////////////////////////////////////////////////////////////
+/// \brief A rectangle whose corners are quarter circles, the radius being clamped to half the smallest side
+////////////////////////////////////////////////////////////
+class RoundedRectPrimitive : public Primitive<RoundedRectPrimitive>
+{
+public:
+	RoundedRectPrimitive() = default;
+	RoundedRectPrimitive(sf::Vector2f const& size, float corner_radius) noexcept;
+
+	void setSize(sf::Vector2f const& size) noexcept;
+	void setCornerRadius(float) noexcept;
+	[[nodiscard]] sf::Vector2f const& getSize()const noexcept { return m_size; }
+	[[nodiscard]] float getCornerRadius()const noexcept { return m_corner_radius; }
+
+	[[nodiscard]] std::uint32_t getPointCount()const noexcept { return 4 * m_corner_points; }
+	[[nodiscard]] sf::Vector2f getPoint(std::uint32_t)const noexcept;
+
+private:
+	void update_corners() noexcept;
+
+	sf::Vector2f m_size{};
+	float m_corner_radius{ 0.f };
+	std::uint32_t m_corner_points{ 1 };//points per corner, 1 for square corners
+};
+
+////////////////////////////////////////////////////////////
+/// \brief A circle with as many points as its radius needs, the same points as an sf::CircleShape with that count
+////////////////////////////////////////////////////////////
+class CirclePrimitive : public Primitive<CirclePrimitive>
+{
+public:
+	CirclePrimitive() = default;
+	explicit CirclePrimitive(float radius) noexcept : m_radius{ radius }, m_point_count{ circle_point_count(radius) } {}
+
+	void setRadius(float radius) noexcept;
+	[[nodiscard]] float getRadius()const noexcept { return m_radius; }
+
+	[[nodiscard]] std::uint32_t getPointCount()const noexcept { return m_point_count; }
+	[[nodiscard]] sf::Vector2f getPoint(std::uint32_t)const noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \return The bounds of the points, from the extremes of the unit circle instead of every point
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] sf::FloatRect getLocalBounds()const;
+
+private:
+	friend class Primitive<CirclePrimitive>;
+
+	////////////////////////////////////////////////////////////
+	/// cos and sin of the angles of getPoint, computed once per point count and per thread
+	////////////////////////////////////////////////////////////
+	struct UnitCircle
+	{
+		std::vector<sf::Vector2f> points;
+		sf::Vector2f min{}, max{};
+	};
+
+	[[nodiscard]] static UnitCircle const& unit_circle(std::uint32_t);
+	void local_points(std::span<sf::Vertex> out)const;
+
+	float m_radius{ 0.f };
+	std::uint32_t m_point_count{ 8 };
+};
+
+static_assert(std::is_trivially_copyable_v<RectPrimitive> && std::is_trivially_copyable_v<RoundedRectPrimitive>
+	&& std::is_trivially_copyable_v<CirclePrimitive>, "Primitives must stay plain values");
+
+template<class _Ty>
+inline void Primitive<_Ty>::setRotation(float angle) noexcept
+{
+	//same normalization as sf::Transformable
+	m_rotation = std::fmod(angle, 360.f);
+	if (m_rotation < 0)
+		m_rotation += 360.f;
+}
+
+template<class _Ty>
+inline sf::Transform Primitive<_Ty>::getTransform()const noexcept
+{
+	const float angle = -m_rotation * 3.141592654f / 180.f;
+	const float cosine = static_cast<float>(std::cos(angle));
+	const float sine = static_cast<float>(std::sin(angle));
+	const float tx = -m_origin.x * cosine - m_origin.y * sine + m_position.x;
+	const float ty = m_origin.x * sine - m_origin.y * cosine + m_position.y;
+
+	return sf::Transform(cosine, sine, tx, -sine, cosine, ty, 0.f, 0.f, 1.f);
+}
+
+template<class _Ty>
+inline sf::FloatRect Primitive<_Ty>::getLocalBounds()const
+{
+	const std::uint32_t count = self().getPointCount();
+	if (count == 0)
+		return {};
+
+	sf::Vector2f min = self().getPoint(0);
+	sf::Vector2f max = min;
+	for (std::uint32_t i = 1; i < count; ++i)
+	{
+		const auto p = self().getPoint(i);
+		min.x = std::min(min.x, p.x);
+		min.y = std::min(min.y, p.y);
+		max.x = std::max(max.x, p.x);
+		max.y = std::max(max.y, p.y);
+	}
+	return { min, max - min };
+}
+
+template<class _Ty>
+inline void Primitive<_Ty>::local_fan(std::vector<sf::Vertex>& fan)const
+{
+	const std::uint32_t count = self().getPointCount();
+	const auto bounds = self().getLocalBounds();
+
+	fan.resize(std::size_t{ count } + 2);
+	fan[0].position = { bounds.left + bounds.width / 2.f, bounds.top + bounds.height / 2.f };
+	self().local_points(std::span(fan).subspan(1, count));
+	fan[std::size_t{ count } + 1].position = fan[1].position;
+
+	//the whole texture over the local bounds, like sf::Shape with its default texture rect
+	const sf::Vector2f tex_size = m_texture ? sf::Vector2f(m_texture->getSize()) : sf::Vector2f();
+	for (auto& v : fan)
+	{
+		v.color = m_color;
+		v.texCoords.x = bounds.width > 0 ? tex_size.x * (v.position.x - bounds.left) / bounds.width : 0;
+		v.texCoords.y = bounds.height > 0 ? tex_size.y * (v.position.y - bounds.top) / bounds.height : 0;
+	}
+}
+
+template<class _Ty>
+inline void Primitive<_Ty>::local_points(std::span<sf::Vertex> out)const
+{
+	for (std::uint32_t i = 0; i < out.size(); ++i)
+		out[i].position = self().getPoint(i);
+}
+
+template<class _Ty>
+inline void Primitive<_Ty>::write_triangles(std::span<sf::Vertex> out)const
+{
+	thread_local std::vector<sf::Vertex> fan;
+	local_fan(fan);
+	if (fan.size() < 3)
+		return;
+
+	const auto transform = getTransform();
+	for (auto& v : fan)
+		v.position = transform.transformPoint(v.position);
+
+	auto* dst = out.data();
+	for (std::size_t i = 1; i + 1 < fan.size(); ++i)
+	{
+		*dst++ = fan[0];
+		*dst++ = fan[i];
+		*dst++ = fan[i + 1];
+	}
+}
+
+template<class _Ty>
+inline void Primitive<_Ty>::draw(sf::RenderTarget& target, sf::RenderStates states)const
+{
+	thread_local std::vector<sf::Vertex> fan;
+	local_fan(fan);
+	if (fan.size() < 3)
+		return;
+
+	states.transform *= getTransform();
+	states.texture = m_texture;
+	target.draw(fan.data(), fan.size(), sf::TriangleFan, states);
+}
+
+#endif
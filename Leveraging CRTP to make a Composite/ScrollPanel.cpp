@@ -0,0 +1,199 @@
+#include "ScrollPanel.h"
+#include <algorithm>
+#include <limits>
+
+ScrollPanel::ScrollPanel(sf::FloatRect const& bounds) : m_bounds{ bounds }
+{
+}
+
+Button& ScrollPanel::get(std::string_view id) const
+{
+	return m_content.get(id);
+}
+
+void ScrollPanel::remove(std::string_view id)
+{
+	m_content.remove(id);
+	m_dirty = true;
+}
+
+void ScrollPanel::clear() noexcept
+{
+	m_index.clear();
+	m_tall.clear();
+	m_content.clear();
+	m_content_size = {};
+	m_scroll = {};
+	m_dirty = false;
+}
+
+void ScrollPanel::rebuild_index()
+{
+	m_index.clear();
+	m_tall.clear();
+	m_tallest = 0.f;
+
+	float max_bottom = 0.f;
+	float max_right = 0.f;
+	std::uint32_t order = 0;
+	m_content.for_each_child([&](Button& child) {
+		const auto b = child.get_globalbounds();
+		const Extent e{ b.top, b.top + b.height, b.left, b.left + b.width, order++, &child };
+		if (b.height > m_bounds.height)
+			m_tall.push_back(e);
+		else
+		{
+			m_index.push_back(e);
+			m_tallest = std::max(m_tallest, b.height);
+		}
+		max_bottom = std::max(max_bottom, e.bottom);
+		max_right = std::max(max_right, e.right);
+		});
+	std::ranges::sort(m_index, {}, &Extent::top);
+
+	m_content_size = { max_right, max_bottom };
+	m_dirty = false;
+	clamp_scroll();
+}
+
+template<class F>
+void ScrollPanel::for_each_visible(F&& f)
+{
+	if (m_dirty)
+		rebuild_index();
+
+	const float top = m_scroll.y;
+	const float bottom = m_scroll.y + m_bounds.height;
+	const float left = m_scroll.x;
+	const float right = m_scroll.x + m_bounds.width;
+
+	const auto visible = [&](Extent const& e) { return e.bottom >= top && e.top <= bottom && e.right >= left && e.left <= right; };
+
+	//an indexed child starting more than m_tallest above the panel ends above it, the scan stops at the first one starting below it
+	m_visible.clear();
+	for (auto it = std::ranges::lower_bound(m_index, top - m_tallest, {}, &Extent::top); it != m_index.end() && it->top <= bottom; ++it)
+		if (visible(*it))
+			m_visible.push_back(&*it);
+	for (auto const& e : m_tall)
+		if (visible(e))
+			m_visible.push_back(&e);
+
+	std::ranges::sort(m_visible, {}, &Extent::order);
+	for (auto const* e : m_visible)
+		f(*e->child);
+}
+
+sf::View ScrollPanel::view_for(sf::RenderTarget const& target)const
+{
+	sf::View view(sf::FloatRect(m_scroll.x, m_scroll.y, m_bounds.width, m_bounds.height));
+
+	const auto size = sf::Vector2f(target.getSize());
+	view.setViewport(sf::FloatRect(m_bounds.left / size.x, m_bounds.top / size.y, m_bounds.width / size.x, m_bounds.height / size.y));
+	return view;
+}
+
+Button::CullStats ScrollPanel::draw(sf::RenderWindow& window)
+{
+	const sf::View previous = window.getView();
+	window.setView(view_for(window));
+
+	Button::CullStats stats;
+	for_each_visible([&](Button& child) {
+		const auto s = child.draw_visible(window);
+		stats.drawn += s.drawn;
+		stats.culled += s.culled;
+		stats.culled_subtrees += s.culled_subtrees;
+		});
+
+	window.setView(previous);
+	return stats;
+}
+
+void ScrollPanel::process_events(sf::Event const& e, sf::RenderWindow const& window)
+{
+	const auto inside = [this](int x, int y) { return m_bounds.contains(static_cast<float>(x), static_cast<float>(y)); };
+	const auto view = view_for(window);
+	const auto to_content = [&](int& x, int& y) {
+		const auto p = window.mapPixelToCoords({ x, y }, view);
+		x = static_cast<int>(p.x);
+		y = static_cast<int>(p.y);
+	};
+
+	sf::Event local = e;
+	switch (e.type)
+	{
+	case sf::Event::MouseWheelScrolled:
+		if (inside(e.mouseWheelScroll.x, e.mouseWheelScroll.y))
+		{
+			const float step = -e.mouseWheelScroll.delta * m_wheel_step;
+			if (e.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel)
+				scroll_by({ 0.f, step });
+			else
+				scroll_by({ step, 0.f });
+		}
+		return;
+	case sf::Event::MouseButtonPressed:
+	case sf::Event::MouseButtonReleased:
+		if (!inside(e.mouseButton.x, e.mouseButton.y))
+			return;
+		to_content(local.mouseButton.x, local.mouseButton.y);
+		break;
+	case sf::Event::MouseMoved:
+		//outside the panel nothing is hovered, even children drawn under the cursor without clipping
+		if (inside(e.mouseMove.x, e.mouseMove.y))
+			to_content(local.mouseMove.x, local.mouseMove.y);
+		else
+			local.mouseMove.x = local.mouseMove.y = std::numeric_limits<int>::min();
+		break;
+	default:
+		break;
+	}
+
+	for_each_visible([&local](Button& child) { child.apply_foreach<&Button::process_events>(local); });
+}
+
+void ScrollPanel::set_scroll(sf::Vector2f const& scroll)
+{
+	m_scroll = scroll;
+	clamp_scroll();
+}
+
+void ScrollPanel::scroll_by(sf::Vector2f const& delta)
+{
+	set_scroll(m_scroll + delta);
+}
+
+void ScrollPanel::set_wheel_step(float step) noexcept
+{
+	m_wheel_step = step;
+}
+
+void ScrollPanel::set_bounds(sf::FloatRect const& bounds)
+{
+	//the height of the panel decides which children are indexed
+	m_dirty = m_dirty || bounds.height != m_bounds.height;
+	m_bounds = bounds;
+	clamp_scroll();
+}
+
+void ScrollPanel::invalidate() noexcept
+{
+	m_dirty = true;
+}
+
+sf::Vector2f ScrollPanel::content_size()
+{
+	if (m_dirty)
+		rebuild_index();
+	return m_content_size;
+}
+
+void ScrollPanel::clamp_scroll()
+{
+	//m_content_size is stale until the index is rebuilt, rebuild_index clamps again with the new size
+	if (m_dirty)
+		return rebuild_index();
+
+	m_scroll.x = std::clamp(m_scroll.x, 0.f, std::max(0.f, m_content_size.x - m_bounds.width));
+	m_scroll.y = std::clamp(m_scroll.y, 0.f, std::max(0.f, m_content_size.y - m_bounds.height));
+}
@@ -0,0 +1,121 @@
+#ifndef SCROLLPANEL_H
+#define SCROLLPANEL_H
+
+#include "Button.h"
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "SFML/Graphics/View.hpp"
+
+////////////////////////////////////////////////////////////
+/// \brief A rectangle of the window showing a scrollable part of its children, clipped to its bounds
+/// Example : ScrollPanel panel({ 100.f, 100.f, 400.f, 600.f });
+/// panel.add("row0", sf::RectangleShape({ 380.f, 40.f })).set_position({ 10.f, 0.f });
+/// panel.process_events(e, App);
+/// panel.draw(App);
+///
+/// Children are positioned in content coordinates : (0, 0) is the top left corner of the panel when not scrolled.
+/// Scrolling only moves the view the children are drawn with, it never touches their positions.
+/// Visible children are found by a binary search in an index sorted by top edge, children higher than the panel
+/// (backgrounds, frames...) are kept apart and always tested. They are drawn in the order of their siblings.
+/// Call invalidate() after moving or resizing children yourself so the index is rebuilt.
+///
+/// The panel isn't a node of a Button tree but owns the root of its children, content() :
+/// every node of a tree is a BasicButton drawn by the same non virtual functions,
+/// so a tree can't hold a node drawing its descendants through another view.
+////////////////////////////////////////////////////////////
+class ScrollPanel
+{
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \param the area of the panel in window coordinates (pixels)
+	////////////////////////////////////////////////////////////
+	explicit ScrollPanel(sf::FloatRect const&);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Same as Container::add, the child is positioned in content coordinates
+	////////////////////////////////////////////////////////////
+	template<class ...Args>
+	[[nodiscard]] Button& add(std::string_view, Args&& ...args);
+
+	[[nodiscard]] Button& get(std::string_view) const;
+	void remove(std::string_view);
+	void clear() noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the children intersecting the panel, then put the previous view of the window back
+	///
+	/// \return The draw_visible counts of the children reached through the index
+	////////////////////////////////////////////////////////////
+	Button::CullStats draw(sf::RenderWindow&);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scroll with the mouse wheel and forward mouse events to the visible children in content coordinates
+	////////////////////////////////////////////////////////////
+	void process_events(sf::Event const&, sf::RenderWindow const&);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scroll the view, clamped to the content
+	/// The index is rebuilt first when children changed since the last draw, so the clamp sees their current size
+	////////////////////////////////////////////////////////////
+	void set_scroll(sf::Vector2f const&);
+	void scroll_by(sf::Vector2f const&);
+	void set_wheel_step(float) noexcept;
+	void set_bounds(sf::FloatRect const&);
+	void invalidate() noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief The root of the children, for visit_preorder, find_path, for_each_child...
+	/// Drawing or batching it directly ignores the clipping and the scroll
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] Button& content() noexcept { return m_content; }
+	[[nodiscard]] Button const& content()const noexcept { return m_content; }
+
+	[[nodiscard]] sf::Vector2f get_scroll()const noexcept { return m_scroll; }
+	[[nodiscard]] sf::FloatRect get_bounds()const noexcept { return m_bounds; }
+
+	////////////////////////////////////////////////////////////
+	/// \return The size of the area covered by the children, in content coordinates
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] sf::Vector2f content_size();
+
+private:
+
+	struct Extent
+	{
+		float top, bottom, left, right;
+		std::uint32_t order;//place of the child among the siblings of the content
+		Button* child;
+	};
+
+	void rebuild_index();
+	void clamp_scroll();
+	[[nodiscard]] sf::View view_for(sf::RenderTarget const&)const;
+
+	template<class F>
+	void for_each_visible(F&&);
+
+	Button m_content;
+	std::vector<Extent> m_index;//children at most as high as the panel, sorted by top
+	std::vector<Extent> m_tall;//the higher ones, tested every frame
+	std::vector<Extent const*> m_visible;//reused from frame to frame
+	float m_tallest{ 0.f };//the height of the highest child in m_index
+	bool m_dirty{ false };
+
+	sf::FloatRect m_bounds;
+	sf::Vector2f m_scroll{};
+	sf::Vector2f m_content_size{};
+	float m_wheel_step{ 40.f };
+};
+
+template<class ...Args>
+inline Button& ScrollPanel::add(std::string_view id, Args&& ...args)
+{
+	auto& child = m_content.add(id, std::forward<Args>(args)...);
+	m_dirty = true;
+	return child;
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef SORTEDBUTTONS_H
+#define SORTEDBUTTONS_H
+
+#include "Button.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// \brief Flat storage of buttons grouped by shape type, one dense array of BasicButton<S> per S in Shapes...
+/// Example : SortedButtons<sf::RectangleShape, sf::CircleShape> grid;
+/// grid.add(sf::CircleShape(10)).change_default_color(sf::Color::Blue);
+/// grid.process_events(e);
+/// grid.draw(App);
+///
+/// Each loop runs once per type over buttons that hold their shape directly (no std::visit, no variant index),
+/// so the shape dispatch is resolved at compile time instead of branching on every button.
+/// Buttons are drawn type after type : all the Shapes[0] buttons, then all the Shapes[1] buttons...
+/// They never move once added, references stay valid until clear().
+////////////////////////////////////////////////////////////
+template<class ...Shapes>
+class SortedButtons
+{
+public:
+	template<class S>
+	static constexpr bool is_stored_v = (std::is_same_v<S, Shapes> || ...);
+
+	SortedButtons() = default;
+	SortedButtons(SortedButtons const&) = delete;
+	SortedButtons& operator=(SortedButtons const&) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Construct a button at the end of the array of its shape type
+	///
+	/// \param the shape, deciding the array, then the other arguments of BasicButton<S>
+	////////////////////////////////////////////////////////////
+	template<class S, class ...Args>
+	BasicButton<std::remove_cvref_t<S>>& add(S&& shape, Args&& ...args);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Call f on every button, one loop per shape type
+	///
+	/// \param a callable taking any BasicButton<S>&, usually a generic lambda
+	////////////////////////////////////////////////////////////
+	template<class F>
+	void for_each(F&& f);
+	template<class F>
+	void for_each(F&& f)const;
+
+	void process_events(sf::Event const& e) { for_each([&e](auto& b) { b.process_events(e); }); }
+	void draw(sf::RenderWindow& window)const { for_each([&window](auto const& b) { b.draw(window); }); }
+	void submit(ButtonBatch& batch)const { for_each([&batch](auto const& b) { batch.push(b); }); }
+
+	void clear() noexcept { std::apply([](auto&... dense) { (dense.clear(), ...); }, m_storage); }
+
+	[[nodiscard]] std::size_t size()const noexcept { return std::apply([](auto const&... dense) { return (dense.size() + ... + 0); }, m_storage); }
+
+	template<class S>
+	[[nodiscard]] std::size_t count()const noexcept { return std::get<Dense<BasicButton<S>>>(m_storage).size(); }
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// Contiguous chunks of raw storage : buttons are built in place and never relocated,
+	/// they can't be moved anyway since their children point back to them
+	////////////////////////////////////////////////////////////
+	template<class T>
+	class Dense
+	{
+	public:
+		static constexpr std::size_t chunk_size{ 256 };
+
+		Dense() = default;
+		Dense(Dense const&) = delete;
+		Dense& operator=(Dense const&) = delete;
+		~Dense() { clear(); }
+
+		template<class ...Args>
+		T& emplace_back(Args&& ...args)
+		{
+			if (m_size == m_chunks.size() * chunk_size)
+				m_chunks.push_back(std::make_unique_for_overwrite<Slot[]>(chunk_size));
+
+			T* elem = ::new (static_cast<void*>(m_chunks[m_size / chunk_size][m_size % chunk_size].bytes)) T(std::forward<Args>(args)...);
+			++m_size;
+			return *elem;
+		}
+
+		template<class F>
+		void for_each(F& f) { for_each(*this, f); }
+		template<class F>
+		void for_each(F& f)const { for_each(*this, f); }
+
+		void clear() noexcept
+		{
+			for_each_destroy();
+			m_size = 0;
+		}
+
+		[[nodiscard]] std::size_t size()const noexcept { return m_size; }
+
+	private:
+		struct Slot
+		{
+			alignas(T) std::byte bytes[sizeof(T)];
+		};
+
+		////////////////////////////////////////////////////////////
+		/// Give f a T const& through a const Dense, a T& otherwise
+		////////////////////////////////////////////////////////////
+		template<class Self, class F>
+		static void for_each(Self& self, F& f)
+		{
+			using elem_t = std::conditional_t<std::is_const_v<Self>, T const, T>;
+			for (std::size_t c = 0, left = self.m_size; left > 0; ++c)
+			{
+				const std::size_t n = std::min(left, chunk_size);
+				Slot* chunk = self.m_chunks[c].get();
+				for (std::size_t i = 0; i < n; ++i)
+					f(*std::launder(reinterpret_cast<elem_t*>(chunk[i].bytes)));
+				left -= n;
+			}
+		}
+
+		void for_each_destroy() noexcept
+		{
+			auto destroy = [](T& elem) { elem.~T(); };
+			for_each(destroy);
+		}
+
+		std::vector<std::unique_ptr<Slot[]>> m_chunks;
+		std::size_t m_size{ 0 };
+	};
+
+	std::tuple<Dense<BasicButton<Shapes>>...> m_storage;
+};
+
+template<class ...Shapes>
+template<class S, class ...Args>
+inline BasicButton<std::remove_cvref_t<S>>& SortedButtons<Shapes...>::add(S&& shape, Args&& ...args)
+{
+	using shape_t = std::remove_cvref_t<S>;
+	static_assert(is_stored_v<shape_t>, "This shape type isn't one of the types of this SortedButtons");
+
+	return std::get<Dense<BasicButton<shape_t>>>(m_storage).emplace_back(std::forward<S>(shape), std::forward<Args>(args)...);
+}
+
+template<class ...Shapes>
+template<class F>
+inline void SortedButtons<Shapes...>::for_each(F&& f)
+{
+	std::apply([&f](auto&... dense) { (dense.for_each(f), ...); }, m_storage);
+}
+
+template<class ...Shapes>
+template<class F>
+inline void SortedButtons<Shapes...>::for_each(F&& f)const
+{
+	std::apply([&f](auto const&... dense) { (dense.for_each(f), ...); }, m_storage);
+}
+
+#endif
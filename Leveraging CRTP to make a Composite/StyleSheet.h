@@ -0,0 +1,122 @@
+#ifndef STYLESHEET_H
+#define STYLESHEET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// \brief A table of named styles for the buttons of type _Ty, what a theme switch rewrites
+/// Example : StyleSheet<Button> sheet;
+/// auto ok = sheet.add("ok", sf::RectangleShape({ 120.f, 40.f }));
+/// sheet.restyle(ok, [&](auto& s) { s.set_color_state(idle, hover, pressed).set_font(&font).set_text_size(20); });
+/// parent.add("ok", sf::Text("OK", font)).set_style(sheet.share(ok));
+///
+/// sheet.restyle([&](std::string_view name, auto& s) { s.set_color_state(...); });//dark theme
+/// if (batch.is_stale()) batch.build_tree(parent);
+///
+/// Restyling only touches the styles : the buttons read their style when they are drawn,
+/// so a theme switch costs the number of styles, not the number of buttons.
+////////////////////////////////////////////////////////////
+template<class _Ty>
+class StyleSheet
+{
+public:
+	using style_t = typename _Ty::style_t;
+	using shape_t = typename _Ty::shape_t;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Position of a style in its sheet, valid as long as the sheet
+	////////////////////////////////////////////////////////////
+	struct Handle
+	{
+		std::uint32_t index;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Create a style with this geometry, white in every state
+	///
+	/// \param a name unique in this sheet, or throw an exception
+	////////////////////////////////////////////////////////////
+	Handle add(std::string_view, shape_t const&);
+
+	////////////////////////////////////////////////////////////
+	/// \return The handle of the style with this name, or throw an exception
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] Handle find(std::string_view)const;
+
+	////////////////////////////////////////////////////////////
+	/// \return The style to give to Button::set_style
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] std::shared_ptr<style_t const> share(Handle h)const { return m_styles.at(h.index).style; }
+	[[nodiscard]] style_t const& operator[](Handle h)const { return *m_styles.at(h.index).style; }
+	[[nodiscard]] std::string_view name(Handle h)const { return m_styles.at(h.index).name; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change one style, every button using it shows the change at the next frame
+	///
+	/// \param a callable taking a style_t&
+	////////////////////////////////////////////////////////////
+	template<class F>
+	void restyle(Handle, F&& edit);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change every style : a theme switch
+	///
+	/// \param a callable taking the name of the style and a style_t&
+	////////////////////////////////////////////////////////////
+	template<class F>
+	void restyle(F&& theme);
+
+	[[nodiscard]] std::size_t size()const noexcept { return m_styles.size(); }
+
+private:
+	struct Entry
+	{
+		std::string name;
+		std::shared_ptr<style_t> style;
+	};
+
+	std::vector<Entry> m_styles;
+};
+
+template<class _Ty>
+inline auto StyleSheet<_Ty>::add(std::string_view name, shape_t const& shape) -> Handle
+{
+	if (std::ranges::find(m_styles, name, &Entry::name) != m_styles.end())
+		throw std::invalid_argument("This style already exists in the sheet");
+
+	m_styles.push_back({ std::string(name), std::make_shared<style_t>(shape) });
+	return { static_cast<std::uint32_t>(m_styles.size() - 1) };
+}
+
+template<class _Ty>
+inline auto StyleSheet<_Ty>::find(std::string_view name)const -> Handle
+{
+	auto it = std::ranges::find(m_styles, name, &Entry::name);
+	if (it == m_styles.end())
+		throw std::range_error("Can't find this style in the sheet");
+
+	return { static_cast<std::uint32_t>(it - m_styles.begin()) };
+}
+
+template<class _Ty>
+template<class F>
+inline void StyleSheet<_Ty>::restyle(Handle h, F&& edit)
+{
+	edit(*m_styles.at(h.index).style);
+}
+
+template<class _Ty>
+template<class F>
+inline void StyleSheet<_Ty>::restyle(F&& theme)
+{
+	for (auto& [name, style] : m_styles)
+		theme(std::string_view(name), *style);
+}
+
+#endif
@@ -0,0 +1,449 @@
+#include "VertexKernel.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define VERTEX_KERNEL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+//gcc and clang (clang-cl too) only emit vector instructions in functions that ask for them, msvc always does.
+//The avx2 paths clear the upper ymm halves themselves before running sse code again, gcc doesn't do it for them
+#if defined(__clang__) || defined(__GNUC__)
+#define VERTEX_KERNEL_SSE2 __attribute__((target("sse2")))
+#define VERTEX_KERNEL_AVX2 __attribute__((target("avx2")))
+#else
+#define VERTEX_KERNEL_SSE2
+#define VERTEX_KERNEL_AVX2
+#endif
+
+using namespace vertex_kernel;
+
+namespace
+{
+	////////////////////////////////////////////////////////////
+	/// Affine part of the sf::Transform of every item, one column per coefficient
+	////////////////////////////////////////////////////////////
+	struct Matrices
+	{
+		std::vector<float> a00, a01, a02, a10, a11, a12;
+
+		void compute(TransformSoA const& t)
+		{
+			const std::size_t n = t.rotation.size();
+			for (auto* column : { &a00, &a01, &a02, &a10, &a11, &a12 })
+				column->resize(n);
+
+			//same operations, in the same order, as sf::Transformable::getTransform
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const float angle = -t.rotation[i] * 3.141592654f / 180.f;
+				const float cosine = static_cast<float>(std::cos(angle));
+				const float sine = static_cast<float>(std::sin(angle));
+				const float sxc = t.scale_x[i] * cosine;
+				const float syc = t.scale_y[i] * cosine;
+				const float sxs = t.scale_x[i] * sine;
+				const float sys = t.scale_y[i] * sine;
+
+				a00[i] = sxc;
+				a01[i] = sys;
+				a02[i] = -t.origin_x[i] * sxc - t.origin_y[i] * sys + t.position_x[i];
+				a10[i] = -sxs;
+				a11[i] = syc;
+				a12[i] = t.origin_x[i] * sxs - t.origin_y[i] * syc + t.position_y[i];
+			}
+		}
+	};
+
+	////////////////////////////////////////////////////////////
+	/// Points of sf::CircleShape for a radius of 1, computed once per point count and per thread
+	////////////////////////////////////////////////////////////
+	struct UnitCircle
+	{
+		std::vector<float> cos, sin;
+		float min_cos{}, max_cos{}, min_sin{}, max_sin{};
+	};
+
+	UnitCircle const& unit_circle(std::uint32_t n)
+	{
+		thread_local std::unordered_map<std::uint32_t, UnitCircle> cache;
+
+		auto [it, inserted] = cache.try_emplace(n);
+		if (inserted)
+		{
+			auto& u = it->second;
+			u.cos.resize(n);
+			u.sin.resize(n);
+
+			//same expression as sf::CircleShape::getPoint
+			constexpr float pi = 3.141592654f;
+			for (std::uint32_t i = 0; i < n; ++i)
+			{
+				const float angle = static_cast<float>(std::size_t{ i } * 2) * pi / static_cast<float>(n) - pi / 2;
+				u.cos[i] = std::cos(angle);
+				u.sin[i] = std::sin(angle);
+			}
+
+			if (n > 0)
+			{
+				const auto [min_c, max_c] = std::minmax_element(u.cos.begin(), u.cos.end());
+				const auto [min_s, max_s] = std::minmax_element(u.sin.begin(), u.sin.end());
+				u.min_cos = *min_c;
+				u.max_cos = *max_c;
+				u.min_sin = *min_s;
+				u.max_sin = *max_s;
+			}
+		}
+		return it->second;
+	}
+
+	struct Scratch
+	{
+		Matrices matrices;
+		std::vector<float> x, y;
+	};
+
+	Scratch& scratch()
+	{
+		thread_local Scratch s;
+		return s;
+	}
+
+	inline void emit_quad(sf::Vertex* out, float const* x, float const* y, sf::Color const& col) noexcept
+	{
+		constexpr int order[quad_vertex_count] = { 0, 1, 2, 0, 2, 3 };
+		for (auto k : order)
+		{
+			out->position = sf::Vector2f(x[k], y[k]);
+			out->color = col;
+			out->texCoords = sf::Vector2f();
+			++out;
+		}
+	}
+
+	inline void emit_fan(sf::Vertex* out, sf::Vector2f const& center, float const* x, float const* y,
+		std::uint32_t n, sf::Color const& col) noexcept
+	{
+		for (std::uint32_t i = 0; i < n; ++i)
+		{
+			const std::uint32_t next = i + 1 == n ? 0 : i + 1;
+			out[0].position = center;
+			out[1].position = sf::Vector2f(x[i], y[i]);
+			out[2].position = sf::Vector2f(x[next], y[next]);
+			for (int k = 0; k < 3; ++k)
+			{
+				out[k].color = col;
+				out[k].texCoords = sf::Vector2f();
+			}
+			out += 3;
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	/// Quads : one lane per rectangle
+	////////////////////////////////////////////////////////////
+	void quads_scalar(Matrices const& m, QuadSoA const& q, std::size_t first, sf::Vertex* out) noexcept
+	{
+		for (std::size_t i = first; i < q.width.size(); ++i)
+		{
+			const float lx[4] = { 0.f, q.width[i], q.width[i], 0.f };
+			const float ly[4] = { 0.f, 0.f, q.height[i], q.height[i] };
+			float x[4], y[4];
+			for (int k = 0; k < 4; ++k)
+			{
+				x[k] = m.a00[i] * lx[k] + m.a01[i] * ly[k] + m.a02[i];
+				y[k] = m.a10[i] * lx[k] + m.a11[i] * ly[k] + m.a12[i];
+			}
+			emit_quad(out + q.offset[i], x, y, q.color[i]);
+		}
+	}
+
+	void quads_scalar(Matrices const& m, QuadSoA const& q, sf::Vertex* out) noexcept
+	{
+		quads_scalar(m, q, 0, out);
+	}
+
+#ifdef VERTEX_KERNEL_X86
+	VERTEX_KERNEL_SSE2 void quads_sse2(Matrices const& m, QuadSoA const& q, sf::Vertex* out) noexcept
+	{
+		const std::size_t n = q.width.size();
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const __m128 a00 = _mm_loadu_ps(&m.a00[i]), a01 = _mm_loadu_ps(&m.a01[i]), a02 = _mm_loadu_ps(&m.a02[i]);
+			const __m128 a10 = _mm_loadu_ps(&m.a10[i]), a11 = _mm_loadu_ps(&m.a11[i]), a12 = _mm_loadu_ps(&m.a12[i]);
+			const __m128 w = _mm_loadu_ps(&q.width[i]), h = _mm_loadu_ps(&q.height[i]), zero = _mm_setzero_ps();
+			const __m128 lx[4] = { zero, w, w, zero };
+			const __m128 ly[4] = { zero, zero, h, h };
+
+			alignas(16) float x[4][4], y[4][4];//[corner][lane]
+			for (int k = 0; k < 4; ++k)
+			{
+				_mm_store_ps(x[k], _mm_add_ps(_mm_add_ps(_mm_mul_ps(a00, lx[k]), _mm_mul_ps(a01, ly[k])), a02));
+				_mm_store_ps(y[k], _mm_add_ps(_mm_add_ps(_mm_mul_ps(a10, lx[k]), _mm_mul_ps(a11, ly[k])), a12));
+			}
+
+			for (int lane = 0; lane < 4; ++lane)
+			{
+				const float cx[4] = { x[0][lane], x[1][lane], x[2][lane], x[3][lane] };
+				const float cy[4] = { y[0][lane], y[1][lane], y[2][lane], y[3][lane] };
+				emit_quad(out + q.offset[i + lane], cx, cy, q.color[i + lane]);
+			}
+		}
+		quads_scalar(m, q, i, out);
+	}
+
+	VERTEX_KERNEL_AVX2 void quads_avx2(Matrices const& m, QuadSoA const& q, sf::Vertex* out) noexcept
+	{
+		const std::size_t n = q.width.size();
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256 a00 = _mm256_loadu_ps(&m.a00[i]), a01 = _mm256_loadu_ps(&m.a01[i]), a02 = _mm256_loadu_ps(&m.a02[i]);
+			const __m256 a10 = _mm256_loadu_ps(&m.a10[i]), a11 = _mm256_loadu_ps(&m.a11[i]), a12 = _mm256_loadu_ps(&m.a12[i]);
+			const __m256 w = _mm256_loadu_ps(&q.width[i]), h = _mm256_loadu_ps(&q.height[i]), zero = _mm256_setzero_ps();
+			const __m256 lx[4] = { zero, w, w, zero };
+			const __m256 ly[4] = { zero, zero, h, h };
+
+			alignas(32) float x[4][8], y[4][8];//[corner][lane]
+			for (int k = 0; k < 4; ++k)
+			{
+				_mm256_store_ps(x[k], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a00, lx[k]), _mm256_mul_ps(a01, ly[k])), a02));
+				_mm256_store_ps(y[k], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a10, lx[k]), _mm256_mul_ps(a11, ly[k])), a12));
+			}
+
+			for (int lane = 0; lane < 8; ++lane)
+			{
+				const float cx[4] = { x[0][lane], x[1][lane], x[2][lane], x[3][lane] };
+				const float cy[4] = { y[0][lane], y[1][lane], y[2][lane], y[3][lane] };
+				emit_quad(out + q.offset[i + lane], cx, cy, q.color[i + lane]);
+			}
+		}
+		_mm256_zeroupper();
+		quads_scalar(m, q, i, out);
+	}
+#endif
+
+	////////////////////////////////////////////////////////////
+	/// Circles : one lane per point of the same circle
+	////////////////////////////////////////////////////////////
+	struct Affine
+	{
+		float a00, a01, a02, a10, a11, a12;
+	};
+
+	void circle_points_scalar(Affine const& a, UnitCircle const& u, float r, std::size_t first, float* x, float* y) noexcept
+	{
+		for (std::size_t i = first; i < u.cos.size(); ++i)
+		{
+			const float lx = r + u.cos[i] * r;
+			const float ly = r + u.sin[i] * r;
+			x[i] = a.a00 * lx + a.a01 * ly + a.a02;
+			y[i] = a.a10 * lx + a.a11 * ly + a.a12;
+		}
+	}
+
+	void circle_points_scalar(Affine const& a, UnitCircle const& u, float r, float* x, float* y) noexcept
+	{
+		circle_points_scalar(a, u, r, 0, x, y);
+	}
+
+#ifdef VERTEX_KERNEL_X86
+	VERTEX_KERNEL_SSE2 void circle_points_sse2(Affine const& a, UnitCircle const& u, float r, float* x, float* y) noexcept
+	{
+		const __m128 a00 = _mm_set1_ps(a.a00), a01 = _mm_set1_ps(a.a01), a02 = _mm_set1_ps(a.a02);
+		const __m128 a10 = _mm_set1_ps(a.a10), a11 = _mm_set1_ps(a.a11), a12 = _mm_set1_ps(a.a12);
+		const __m128 radius = _mm_set1_ps(r);
+
+		const std::size_t n = u.cos.size();
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const __m128 lx = _mm_add_ps(radius, _mm_mul_ps(_mm_loadu_ps(&u.cos[i]), radius));
+			const __m128 ly = _mm_add_ps(radius, _mm_mul_ps(_mm_loadu_ps(&u.sin[i]), radius));
+			_mm_storeu_ps(x + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(a00, lx), _mm_mul_ps(a01, ly)), a02));
+			_mm_storeu_ps(y + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(a10, lx), _mm_mul_ps(a11, ly)), a12));
+		}
+		circle_points_scalar(a, u, r, i, x, y);
+	}
+
+	VERTEX_KERNEL_AVX2 void circle_points_avx2(Affine const& a, UnitCircle const& u, float r, float* x, float* y) noexcept
+	{
+		const __m256 a00 = _mm256_set1_ps(a.a00), a01 = _mm256_set1_ps(a.a01), a02 = _mm256_set1_ps(a.a02);
+		const __m256 a10 = _mm256_set1_ps(a.a10), a11 = _mm256_set1_ps(a.a11), a12 = _mm256_set1_ps(a.a12);
+		const __m256 radius = _mm256_set1_ps(r);
+
+		const std::size_t n = u.cos.size();
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256 lx = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_loadu_ps(&u.cos[i]), radius));
+			const __m256 ly = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_loadu_ps(&u.sin[i]), radius));
+			_mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a00, lx), _mm256_mul_ps(a01, ly)), a02));
+			_mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a10, lx), _mm256_mul_ps(a11, ly)), a12));
+		}
+		_mm256_zeroupper();
+		circle_points_scalar(a, u, r, i, x, y);
+	}
+#endif
+
+	////////////////////////////////////////////////////////////
+	/// Runtime dispatch
+	////////////////////////////////////////////////////////////
+	using quads_fn = void(*)(Matrices const&, QuadSoA const&, sf::Vertex*) noexcept;
+	using circle_points_fn = void(*)(Affine const&, UnitCircle const&, float, float*, float*) noexcept;
+
+	Isa detect() noexcept
+	{
+#ifdef VERTEX_KERNEL_X86
+		unsigned regs[4]{};//eax, ebx, ecx, edx
+		const auto cpuid = [&regs](unsigned leaf) {
+#if defined(_MSC_VER) && !defined(__clang__)
+			int r[4]{};
+			__cpuidex(r, static_cast<int>(leaf), 0);
+			for (int i = 0; i < 4; ++i)
+				regs[i] = static_cast<unsigned>(r[i]);
+#else
+			__cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+		};
+
+		cpuid(1);
+		if (!(regs[3] & (1u << 26)))
+			return Isa::Scalar;
+
+		const bool osxsave = regs[2] & (1u << 27);
+		const bool avx = regs[2] & (1u << 28);
+		if (!osxsave || !avx)
+			return Isa::SSE2;
+
+		//the OS must save the ymm registers on context switches
+#if defined(_MSC_VER) && !defined(__clang__)
+		const auto xcr0 = _xgetbv(0);
+#else
+		unsigned lo{}, hi{};
+		__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+		const auto xcr0 = (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+		if ((xcr0 & 6) != 6)
+			return Isa::SSE2;
+
+		cpuid(7);
+		return (regs[1] & (1u << 5)) ? Isa::AVX2 : Isa::SSE2;
+#else
+		return Isa::Scalar;
+#endif
+	}
+
+	std::atomic<Isa>& active() noexcept
+	{
+		static std::atomic<Isa> isa{ detected_isa() };
+		return isa;
+	}
+
+	quads_fn select_quads(Isa isa) noexcept
+	{
+#ifdef VERTEX_KERNEL_X86
+		switch (isa)
+		{
+		case Isa::AVX2:
+			return &quads_avx2;
+		case Isa::SSE2:
+			return &quads_sse2;
+		default:
+			break;
+		}
+#endif
+		return &quads_scalar;
+	}
+
+	circle_points_fn select_circle_points(Isa isa) noexcept
+	{
+#ifdef VERTEX_KERNEL_X86
+		switch (isa)
+		{
+		case Isa::AVX2:
+			return &circle_points_avx2;
+		case Isa::SSE2:
+			return &circle_points_sse2;
+		default:
+			break;
+		}
+#endif
+		return &circle_points_scalar;
+	}
+}
+
+Isa vertex_kernel::detected_isa() noexcept
+{
+	static const Isa isa = detect();
+	return isa;
+}
+
+Isa vertex_kernel::active_isa() noexcept
+{
+	return active().load(std::memory_order_relaxed);
+}
+
+void vertex_kernel::force_isa(Isa isa) noexcept
+{
+	active().store(std::min(isa, detected_isa()), std::memory_order_relaxed);
+}
+
+void vertex_kernel::generate_quads(QuadSoA const& q, std::span<sf::Vertex> out) noexcept
+{
+	if (q.width.empty())
+		return;
+
+	auto& m = scratch().matrices;
+	m.compute(q.transform);
+	select_quads(active_isa())(m, q, out.data());
+}
+
+void vertex_kernel::generate_circles(CircleSoA const& c, std::span<sf::Vertex> out)
+{
+	if (c.radius.empty())
+		return;
+
+	auto& s = scratch();
+	s.matrices.compute(c.transform);
+	const auto points = select_circle_points(active_isa());
+
+	for (std::size_t i = 0; i < c.radius.size(); ++i)
+	{
+		const std::uint32_t n = c.point_count[i];
+		if (n == 0)
+			continue;
+
+		const auto& u = unit_circle(n);
+		const float r = c.radius[i];
+		const Affine a{ s.matrices.a00[i], s.matrices.a01[i], s.matrices.a02[i],
+			s.matrices.a10[i], s.matrices.a11[i], s.matrices.a12[i] };
+
+		if (s.x.size() < n)
+		{
+			s.x.resize(n);
+			s.y.resize(n);
+		}
+		points(a, u, r, s.x.data(), s.y.data());
+
+		//sf::Shape puts the fan center in the middle of the local bounds of its points
+		const float left = std::min(r + u.min_cos * r, r + u.max_cos * r);
+		const float right = std::max(r + u.min_cos * r, r + u.max_cos * r);
+		const float top = std::min(r + u.min_sin * r, r + u.max_sin * r);
+		const float bottom = std::max(r + u.min_sin * r, r + u.max_sin * r);
+		const float cx = left + (right - left) / 2;
+		const float cy = top + (bottom - top) / 2;
+		const sf::Vector2f center(a.a00 * cx + a.a01 * cy + a.a02, a.a10 * cx + a.a11 * cy + a.a12);
+
+		emit_fan(out.data() + c.offset[i], center, s.x.data(), s.y.data(), n, c.color[i]);
+	}
+}
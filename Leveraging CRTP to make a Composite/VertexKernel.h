@@ -0,0 +1,87 @@
+#ifndef VERTEXKERNEL_H
+#define VERTEXKERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "SFML/Graphics/Vertex.hpp"
+
+namespace vertex_kernel
+{
+	enum class Isa : std::uint8_t { Scalar, SSE2, AVX2 };
+
+	////////////////////////////////////////////////////////////
+	/// \brief Number of vertices written for one quad / one circle fan, both as sf::Triangles
+	////////////////////////////////////////////////////////////
+	constexpr std::uint32_t quad_vertex_count = 6;
+	constexpr std::uint32_t circle_vertex_count(std::uint32_t point_count) noexcept { return 3 * point_count; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief N transformables stored column by column, with the same meaning as sf::Transformable
+	/// (rotation in degrees, origin in local coordinates)
+	////////////////////////////////////////////////////////////
+	struct TransformSoA
+	{
+		std::span<const float> position_x, position_y;
+		std::span<const float> origin_x, origin_y;
+		std::span<const float> rotation;
+		std::span<const float> scale_x, scale_y;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief N rectangles, each one written at out[offset[i]] as two triangles
+	////////////////////////////////////////////////////////////
+	struct QuadSoA
+	{
+		TransformSoA transform;
+		std::span<const float> width, height;
+		std::span<const sf::Color> color;
+		std::span<const std::uint32_t> offset;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief N circles, each one written at out[offset[i]] as point_count[i] triangles around its center
+	////////////////////////////////////////////////////////////
+	struct CircleSoA
+	{
+		TransformSoA transform;
+		std::span<const float> radius;
+		std::span<const std::uint32_t> point_count;
+		std::span<const sf::Color> color;
+		std::span<const std::uint32_t> offset;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \return The best instruction set supported by the running CPU
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] Isa detected_isa() noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \return The instruction set used by generate_quads and generate_circles
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] Isa active_isa() noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Select another code path, clamped to what the CPU supports (benchmarks, comparisons)
+	////////////////////////////////////////////////////////////
+	void force_isa(Isa) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Generate world space vertices for every quad, bit-exact with
+	/// sf::RectangleShape::getTransform().transformPoint(getPoint(i))
+	/// (checked against sf::Shape on every instruction set by the VertexKernelTest project, which also times them)
+	///
+	/// \param out must hold offset[i] + quad_vertex_count vertices for every quad
+	////////////////////////////////////////////////////////////
+	void generate_quads(QuadSoA const&, std::span<sf::Vertex> out) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Generate world space vertices for every circle, bit-exact with the outline and the fan
+	/// center of sf::CircleShape
+	///
+	/// \param out must hold offset[i] + circle_vertex_count(point_count[i]) vertices for every circle
+	////////////////////////////////////////////////////////////
+	void generate_circles(CircleSoA const&, std::span<sf::Vertex> out);
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include "VirtualList.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+VirtualList::VirtualList(Button& parent, std::string_view id, Button::shape_t const& row_shape, sf::Text const& row_text, std::size_t item_count, float row_extent, binder_t bind) :
+	m_node{ &parent.add(id, sf::Text()) }, m_row_shape{ row_shape }, m_row_text{ row_text }, m_bind{ std::move(bind) }, m_item_count{ item_count }, m_row_extent{ row_extent }
+{
+}
+
+void VirtualList::update(sf::View const& view)
+{
+	if (m_item_count == 0 || m_row_extent <= 0.f)
+	{
+		m_first = m_last = 0;
+		park_hidden_rows();
+		return;
+	}
+
+	const auto visible = view.getInverseTransform().transformRect(sf::FloatRect(-1.f, -1.f, 2.f, 2.f));
+	const double count = static_cast<double>(m_item_count);
+	const double top = std::floor((visible.top - m_position.y) / static_cast<double>(m_row_extent));
+	const double bottom = std::ceil((visible.top + visible.height - m_position.y) / static_cast<double>(m_row_extent));
+	m_first = static_cast<std::size_t>(std::clamp(top, 0., count));
+	m_last = static_cast<std::size_t>(std::clamp(bottom, static_cast<double>(m_first), count));
+
+	grow(m_last - m_first);
+
+	//item i always lives in row i % row_count, so scrolling by one row only rebinds one row
+	for (std::size_t i = m_first; i < m_last; ++i)
+	{
+		auto& row = m_rows[i % m_rows.size()];
+		if (!row.shown)
+		{
+			m_spare.move_child(*row.button, *m_node);
+			row.shown = true;
+		}
+		if (row.item == i)
+			continue;
+
+		row.item = i;
+		row.button->set_position({ m_position.x, m_position.y + static_cast<float>(i) * m_row_extent });
+		m_bind(*row.button, i);
+	}
+	park_hidden_rows();
+}
+
+void VirtualList::park_hidden_rows()
+{
+	//fewer visible items than rows : the rows left over leave the tree, still bound to their last item
+	for (std::size_t k = m_last - m_first; k < m_rows.size(); ++k)
+	{
+		auto& row = m_rows[(m_first + k) % m_rows.size()];
+		if (row.shown)
+		{
+			m_node->move_child(*row.button, m_spare);
+			row.shown = false;
+		}
+	}
+}
+
+void VirtualList::grow(std::size_t visible_rows)
+{
+	if (visible_rows <= m_rows.size())
+		return;
+
+	m_rows.reserve(visible_rows);
+	while (m_rows.size() < visible_rows)
+	{
+		const auto id = std::to_string(m_rows.size());
+		auto& button = m_spare.add(id, m_row_shape, m_row_text);
+		m_rows.push_back({ &button, no_item, false });
+	}
+
+	//the item -> row mapping depends on the number of rows
+	invalidate();
+}
+
+void VirtualList::draw(sf::RenderWindow& window)const
+{
+	m_node->for_each_child([&](Button const& row) { row.draw(window); });
+}
+
+void VirtualList::process_events(sf::Event const& e)
+{
+	m_node->apply_foreach<&Button::process_events>(e);
+}
+
+void VirtualList::set_item_count(std::size_t item_count) noexcept
+{
+	m_item_count = item_count;
+	m_first = m_last = 0;
+	invalidate();
+}
+
+void VirtualList::set_position(sf::Vector2f const& position) noexcept
+{
+	m_position = position;
+	invalidate();
+}
+
+void VirtualList::invalidate() noexcept
+{
+	for (auto& row : m_rows)
+		row.item = no_item;
+}
+
+Button* VirtualList::get_row(std::size_t item) noexcept
+{
+	return item >= m_first && item < m_last ? &row_at(item) : nullptr;
+}
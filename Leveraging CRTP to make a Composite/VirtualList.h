@@ -0,0 +1,103 @@
+#ifndef VIRTUALLIST_H
+#define VIRTUALLIST_H
+
+#include "Button.h"
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <vector>
+#include "SFML/Graphics/View.hpp"
+
+////////////////////////////////////////////////////////////
+/// \brief A vertical list of item_count rows where only the rows inside the view exist as buttons
+/// Example : VirtualList list(menu, "inventory", sf::RectangleShape({ 400.f, 40.f }), { "", font }, 100'000, 40.f,
+///		[&](Button& row, std::size_t i) { row.set_string(items[i]).center_text(); });
+/// list.update(App.getView());
+/// menu.draw_visible(App);
+///
+/// The list adds a node to the tree of its parent and the visible rows are the children of that node,
+/// so they are drawn, batched and found like any other button. Rows not showing an item are kept out of the tree.
+/// Rows are recycled while scrolling : the binder is called again on a row each time it shows another item,
+/// so it must set everything that depends on the item. Memory and per frame cost depend on the visible rows only.
+/// The list keeps a reference to its node : remove the node only after the list is destroyed.
+////////////////////////////////////////////////////////////
+class VirtualList
+{
+public:
+	using binder_t = std::function<void(Button&, std::size_t)>;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Every row is built from the same shape and text, then positioned and given to the binder
+	///
+	/// \param the parent of the node of the list and its id, the shape and the text of one row,
+	/// the number of items, the height of one row and the binder
+	////////////////////////////////////////////////////////////
+	VirtualList(Button& parent, std::string_view id, Button::shape_t const&, sf::Text const&, std::size_t item_count, float row_extent, binder_t);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Materialize the rows intersecting the view, rebinding only the rows whose item changed
+	////////////////////////////////////////////////////////////
+	void update(sf::View const&);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw or forward the event to the visible rows only, without the rest of the tree
+	////////////////////////////////////////////////////////////
+	void draw(sf::RenderWindow&)const;
+	void process_events(sf::Event const&);
+
+	////////////////////////////////////////////////////////////
+	/// \return The node of the list in the tree, the parent of the visible rows
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] Button& node()const noexcept { return *m_node; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change the number of items, every visible row is bound again at the next update
+	////////////////////////////////////////////////////////////
+	void set_item_count(std::size_t) noexcept;
+	void set_position(sf::Vector2f const&) noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Bind every visible row again at the next update, when the items changed but not their count
+	////////////////////////////////////////////////////////////
+	void invalidate() noexcept;
+
+	////////////////////////////////////////////////////////////
+	/// \return The row currently showing this item, nullptr if it is not visible
+	////////////////////////////////////////////////////////////
+	[[nodiscard]] Button* get_row(std::size_t item) noexcept;
+
+	[[nodiscard]] std::size_t item_count()const noexcept { return m_item_count; }
+	[[nodiscard]] std::size_t row_count()const noexcept { return m_rows.size(); }
+	[[nodiscard]] float content_extent()const noexcept { return static_cast<float>(m_item_count) * m_row_extent; }
+
+private:
+	static constexpr std::size_t no_item{ std::numeric_limits<std::size_t>::max() };
+
+	struct Row
+	{
+		Button* button;
+		std::size_t item;
+		bool shown;//child of m_node rather than of m_spare
+	};
+
+	void grow(std::size_t);
+	void park_hidden_rows();
+	[[nodiscard]] Button& row_at(std::size_t item)const noexcept { return *m_rows[item % m_rows.size()].button; }
+
+	Button* m_node;
+	Button m_spare;//the rows showing no item
+	Button::shape_t m_row_shape;
+	sf::Text m_row_text;
+	binder_t m_bind;
+
+	std::vector<Row> m_rows;
+	std::size_t m_item_count;
+	float m_row_extent;
+	sf::Vector2f m_position{};
+
+	std::size_t m_first{ 0 };
+	std::size_t m_last{ 0 };
+};
+
+#endif
@@ -26,8 +26,8 @@ int main()
 
 	Button& childOfchild1 = child2.add("childOfchild1", sf::CircleShape(30));
 
-	parent.get("child1Name").set_position({900.f,900.f});
-	parent.get("child2Name").create_function_call([]() { std::cout << "print whatever" << "\n"; });
+	parent.get("child1Name"_id).set_position({900.f,900.f});
+	parent.get("child2Name"_id).create_function_call([]() { std::cout << "print whatever" << "\n"; });
 
 	while (App.isOpen())
 	{
@@ -0,0 +1,203 @@
+#include "VertexKernel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "SFML/Graphics/CircleShape.hpp"
+#include "SFML/Graphics/RectangleShape.hpp"
+
+//TEST : the vertex kernel against sf::Shape, bit for bit, on every instruction set the CPU has, then its timings
+
+using namespace vertex_kernel;
+
+namespace
+{
+	constexpr std::size_t shape_count = 1003;//not a multiple of the vector widths : the tails are checked too
+	constexpr int bench_iterations = 200;
+
+	////////////////////////////////////////////////////////////
+	/// The columns given to the kernel, filled from the getters of sf::Transformable like ButtonBatch does
+	////////////////////////////////////////////////////////////
+	struct Transforms
+	{
+		std::vector<float> position_x, position_y, origin_x, origin_y, rotation, scale_x, scale_y;
+
+		void push(sf::Transformable const& t)
+		{
+			position_x.push_back(t.getPosition().x);
+			position_y.push_back(t.getPosition().y);
+			origin_x.push_back(t.getOrigin().x);
+			origin_y.push_back(t.getOrigin().y);
+			rotation.push_back(t.getRotation());
+			scale_x.push_back(t.getScale().x);
+			scale_y.push_back(t.getScale().y);
+		}
+
+		[[nodiscard]] TransformSoA view() const noexcept { return { position_x, position_y, origin_x, origin_y, rotation, scale_x, scale_y }; }
+	};
+
+	struct Scene
+	{
+		std::vector<sf::RectangleShape> rectangles;
+		std::vector<sf::CircleShape> circles;
+
+		Transforms quad_transforms, circle_transforms;
+		std::vector<float> width, height, radius;
+		std::vector<std::uint32_t> points, quad_offset, circle_offset;
+		std::vector<sf::Color> quad_color, circle_color;
+		std::uint32_t quad_vertices{ 0 }, circle_vertices{ 0 };
+
+		[[nodiscard]] QuadSoA quads() const noexcept { return { quad_transforms.view(), width, height, quad_color, quad_offset }; }
+		[[nodiscard]] CircleSoA fans() const noexcept { return { circle_transforms.view(), radius, points, circle_color, circle_offset }; }
+	};
+
+	////////////////////////////////////////////////////////////
+	/// Random shapes, rotations outside [0, 360) and negative scales included : sf::Transformable normalizes the first ones
+	////////////////////////////////////////////////////////////
+	Scene make_scene()
+	{
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> coordinate(-500.f, 500.f), angle(-720.f, 720.f), scale(-5.f, 5.f), size(1.f, 500.f);
+
+		Scene s;
+		for (std::size_t i = 0; i < shape_count; ++i)
+		{
+			const sf::Color color(static_cast<sf::Uint8>(i), static_cast<sf::Uint8>(i * 7), static_cast<sf::Uint8>(i * 13));
+
+			auto& rect = s.rectangles.emplace_back(sf::Vector2f(size(rng), size(rng)));
+			rect.setPosition(coordinate(rng), coordinate(rng));
+			rect.setOrigin(coordinate(rng) / 5.f, coordinate(rng) / 5.f);
+			rect.setRotation(angle(rng));
+			rect.setScale(scale(rng), scale(rng));
+			rect.setFillColor(color);
+
+			s.quad_transforms.push(rect);
+			s.width.push_back(rect.getSize().x);
+			s.height.push_back(rect.getSize().y);
+			s.quad_color.push_back(color);
+			s.quad_offset.push_back(s.quad_vertices);
+			s.quad_vertices += quad_vertex_count;
+
+			auto& circle = s.circles.emplace_back(size(rng) / 5.f, 3 + i % 40);
+			circle.setPosition(coordinate(rng), coordinate(rng));
+			circle.setOrigin(coordinate(rng) / 5.f, coordinate(rng) / 5.f);
+			circle.setRotation(angle(rng));
+			circle.setScale(scale(rng), scale(rng));
+			circle.setFillColor(color);
+
+			const auto n = static_cast<std::uint32_t>(circle.getPointCount());
+			s.circle_transforms.push(circle);
+			s.radius.push_back(circle.getRadius());
+			s.points.push_back(n);
+			s.circle_color.push_back(color);
+			s.circle_offset.push_back(s.circle_vertices);
+			s.circle_vertices += circle_vertex_count(n);
+		}
+		return s;
+	}
+
+	bool same(sf::Vertex const& v, sf::Vector2f const& position, sf::Color const& color) noexcept
+	{
+		return std::memcmp(&v.position, &position, sizeof(position)) == 0 && v.color == color && v.texCoords == sf::Vector2f();
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \return The number of vertices differing from what sf::Shape gives : its transform applied to getPoint,
+	/// and for the fan center to the center of its local bounds
+	////////////////////////////////////////////////////////////
+	std::size_t count_mismatches(Scene const& s, std::span<sf::Vertex const> quads, std::span<sf::Vertex const> fans)
+	{
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < shape_count; ++i)
+		{
+			auto const& rect = s.rectangles[i];
+			auto const& t = rect.getTransform();
+			constexpr std::size_t order[quad_vertex_count] = { 0, 1, 2, 0, 2, 3 };
+			for (std::size_t k = 0; k < quad_vertex_count; ++k)
+				mismatches += !same(quads[s.quad_offset[i] + k], t.transformPoint(rect.getPoint(order[k])), rect.getFillColor());
+
+			auto const& circle = s.circles[i];
+			auto const& ct = circle.getTransform();
+			const auto bounds = circle.getLocalBounds();
+			const auto center = ct.transformPoint(bounds.left + bounds.width / 2.f, bounds.top + bounds.height / 2.f);
+			const std::size_t n = circle.getPointCount();
+			for (std::size_t j = 0; j < n; ++j)
+			{
+				auto const* fan = &fans[s.circle_offset[i] + 3 * j];
+				mismatches += !same(fan[0], center, circle.getFillColor());
+				mismatches += !same(fan[1], ct.transformPoint(circle.getPoint(j)), circle.getFillColor());
+				mismatches += !same(fan[2], ct.transformPoint(circle.getPoint((j + 1) % n)), circle.getFillColor());
+			}
+		}
+		return mismatches;
+	}
+
+	template<class F>
+	double microseconds_per_call(F&& f)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < bench_iterations; ++i)
+			f();
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / bench_iterations;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// What the same vertices cost through sf::Transform, one point at a time
+	////////////////////////////////////////////////////////////
+	void bench_reference(Scene const& s, std::span<sf::Vertex> quads, std::span<sf::Vertex> fans)
+	{
+		const double quad_us = microseconds_per_call([&] {
+			for (std::size_t i = 0; i < shape_count; ++i)
+			{
+				auto const& t = s.rectangles[i].getTransform();
+				for (std::size_t k = 0; k < 4; ++k)
+					quads[s.quad_offset[i] + k].position = t.transformPoint(s.rectangles[i].getPoint(k));
+			}
+			});
+		const double fan_us = microseconds_per_call([&] {
+			for (std::size_t i = 0; i < shape_count; ++i)
+			{
+				auto const& t = s.circles[i].getTransform();
+				for (std::size_t j = 0; j < s.points[i]; ++j)
+					fans[s.circle_offset[i] + 3 * j + 1].position = t.transformPoint(s.circles[i].getPoint(j));
+			}
+			});
+		std::printf("sf::Transform  quads %8.1f us  circles %8.1f us\n", quad_us, fan_us);
+	}
+}
+
+int main()
+{
+	const Scene scene = make_scene();
+	std::vector<sf::Vertex> quads(scene.quad_vertices), fans(scene.circle_vertices);
+
+	constexpr char const* names[] = { "scalar", "sse2", "avx2" };
+	std::size_t failures = 0;
+	std::printf("%zu rectangles and %zu circles of 3 to 42 points, per call :\n", shape_count, shape_count);
+	for (const Isa isa : { Isa::Scalar, Isa::SSE2, Isa::AVX2 })
+	{
+		force_isa(isa);
+		if (active_isa() != isa)
+		{
+			std::printf("%-14s not supported by this CPU\n", names[static_cast<int>(isa)]);
+			continue;
+		}
+
+		std::ranges::fill(quads, sf::Vertex());
+		std::ranges::fill(fans, sf::Vertex());
+		generate_quads(scene.quads(), quads);
+		generate_circles(scene.fans(), fans);
+		const std::size_t mismatches = count_mismatches(scene, quads, fans);
+		failures += mismatches;
+
+		const double quad_us = microseconds_per_call([&] { generate_quads(scene.quads(), quads); });
+		const double fan_us = microseconds_per_call([&] { generate_circles(scene.fans(), fans); });
+		std::printf("%-14s quads %8.1f us  circles %8.1f us  %zu vertices differ from sf::Shape\n", names[static_cast<int>(isa)], quad_us, fan_us, mismatches);
+	}
+	force_isa(detected_isa());
+	bench_reference(scene, quads, fans);
+
+	return failures == 0 ? 0 : 1;
+}